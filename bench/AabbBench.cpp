@@ -0,0 +1,96 @@
+// Microbenchmark: one box against many targets, comparing the per-pair
+// SDL_HasRectIntersectionFloat path with each compiled AabbBatch kernel.
+#include <SDL3/SDL.h>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AabbBatch.h"
+
+struct BenchOptions {
+    int targets = 4096;
+    int probes = 1024;
+    int repetitions = 20;
+};
+
+static double SecondsSince(Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void Report(const char* name, double seconds, long long pairs, long long hits) {
+    std::cout << name << ": " << (seconds * 1e9 / pairs) << " ns/pair, "
+              << hits << " hits" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--targets") options.targets = std::atoi(argv[i + 1]);
+        else if (arg == "--probes") options.probes = std::atoi(argv[i + 1]);
+        else if (arg == "--reps") options.repetitions = std::atoi(argv[i + 1]);
+    }
+
+    // Enemy-sized targets and bullet-sized probes scattered over the field
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> x(0.0f, 800.0f);
+    std::uniform_real_distribution<float> y(0.0f, 600.0f);
+
+    std::vector<SDL_FRect> targets(options.targets);
+    AabbBatch batch;
+    for (auto& rect : targets) {
+        rect = SDL_FRect{x(gen), y(gen), 30.0f, 30.0f};
+        batch.Add(rect);
+    }
+
+    std::vector<SDL_FRect> probes(options.probes);
+    for (auto& rect : probes) {
+        rect = SDL_FRect{x(gen), y(gen), 5.0f, 15.0f};
+    }
+
+    const long long pairs = (long long)options.targets * options.probes * options.repetitions;
+    std::cout << options.targets << " targets x " << options.probes << " probes x "
+              << options.repetitions << " reps" << std::endl;
+
+    // Current path: one SDL call per pair
+    long long sdlHits = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int rep = 0; rep < options.repetitions; rep++) {
+        for (const auto& probe : probes) {
+            for (const auto& target : targets) {
+                sdlHits += SDL_HasRectIntersectionFloat(&probe, &target) ? 1 : 0;
+            }
+        }
+    }
+    Report("SDL_HasRectIntersectionFloat", SecondsSince(start), pairs, sdlHits);
+
+    int status = 0;
+    for (AabbKernel kernel : {AabbKernel::Scalar, AabbKernel::SSE2, AabbKernel::AVX2}) {
+        AabbOverlapFn overlap = GetAabbKernel(kernel);
+        if (!overlap) {
+            std::cout << GetAabbKernelName(kernel) << ": unavailable" << std::endl;
+            continue;
+        }
+
+        long long hits = 0;
+        start = SDL_GetPerformanceCounter();
+        for (int rep = 0; rep < options.repetitions; rep++) {
+            for (const auto& probe : probes) {
+                for (int block = 0; block < batch.BlockCount(); block++) {
+                    hits += std::popcount(overlap(probe, batch, block * AabbBatch::blockSize));
+                }
+            }
+        }
+        Report(GetAabbKernelName(kernel), SecondsSince(start), pairs, hits);
+
+        if (hits != sdlHits) {
+            std::cerr << GetAabbKernelName(kernel) << " disagrees with SDL!" << std::endl;
+            status = 1;
+        }
+    }
+
+    std::cout << "Runtime dispatch selects: " << GetAabbKernelName(DetectAabbKernel()) << std::endl;
+    return status;
+}
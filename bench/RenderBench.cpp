@@ -0,0 +1,247 @@
+// Render benchmark: draws representative boards and raw Graphics/TextRenderer
+// workloads into an offscreen software renderer, so it runs on machines with
+// no GPU or display. Reports us/frame percentiles, draw calls and texture
+// state changes per frame as JSON.
+//
+//   invaders_render_bench [--frames N] [--warmup N] [--out FILE]
+//
+// Run from the build directory so the font in assets/ is found.
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "Graphics.h"
+#include "TextRenderer.h"
+#include "Barrier.h"
+
+struct BenchOptions {
+    int frames = 500;
+    int warmup = 30;
+    std::string outPath;
+};
+
+static const int boardWidth = 800;
+static const int boardHeight = 600;
+static const float tickSeconds = 1.0f / 120.0f;
+static const char* fontPath = "assets/fonts/DejaVuSans.ttf";
+
+struct BoardResult {
+    std::string name;
+    double meanUS = 0.0;
+    double p50US = 0.0;
+    double p99US = 0.0;
+    RenderStats stats;  // Of the last frame
+};
+
+// A workload draws one complete frame, ending with Present
+struct Workload {
+    const char* name;
+    std::function<void()> setupFrame;  // Untimed, before each frame; may be empty
+    std::function<void()> drawFrame;
+    std::function<RenderStats()> stats;
+};
+
+static BoardResult Run(const Workload& workload, const BenchOptions& options) {
+    std::vector<Uint64> samples;
+    samples.reserve(options.frames);
+
+    for (int frame = -options.warmup; frame < options.frames; frame++) {
+        if (workload.setupFrame) {
+            workload.setupFrame();
+        }
+        Uint64 start = SDL_GetTicksNS();
+        workload.drawFrame();
+        Uint64 elapsed = SDL_GetTicksNS() - start;
+        if (frame >= 0) {
+            samples.push_back(elapsed);
+        }
+    }
+
+    BoardResult result;
+    result.name = workload.name;
+    result.stats = workload.stats();
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (Uint64 sample : samples) {
+        sum += (double)sample;
+    }
+    result.meanUS = sum / samples.size() / 1000.0;
+    result.p50US = samples[samples.size() / 2] / 1000.0;
+    result.p99US = samples[(size_t)(0.99 * (samples.size() - 1) + 0.5)] / 1000.0;
+    return result;
+}
+
+static void PressKey(Game& game, SDL_Scancode key) {
+    SDL_Event event{};
+    event.type = SDL_EVENT_KEY_DOWN;
+    event.key.scancode = key;
+    game.HandleEvent(event);
+}
+
+static std::unique_ptr<Game> NewGame(SDL_Renderer* renderer, int level) {
+    auto game = std::make_unique<Game>(nullptr, renderer);
+    game->Initialize();
+    while (game->GetLevel() < level) {
+        game->AdvanceLevel();
+    }
+    return game;
+}
+
+static Workload GameBoard(const char* name, Game& game, std::function<void()> setupFrame = nullptr) {
+    return Workload{
+        name,
+        std::move(setupFrame),
+        [&game]() { game.Render(); },
+        [&game]() { return game.GetGraphics()->GetLastFrameStats(); }
+    };
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) options.frames = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && i + 1 < argc) options.warmup = std::atoi(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) options.outPath = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--warmup N] [--out FILE]" << std::endl;
+            return -1;
+        }
+    }
+    if (options.frames <= 0 || options.warmup < 0) {
+        std::cerr << "--frames must be positive" << std::endl;
+        return -1;
+    }
+
+    // Draw into a plain surface: no window, video driver or GPU needed
+    SDL_Surface* target = SDL_CreateSurface(boardWidth, boardHeight, SDL_PIXELFORMAT_XRGB8888);
+    if (!target) {
+        std::cerr << "Surface could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        return -1;
+    }
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(target);
+    if (!renderer) {
+        std::cerr << "Software renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        SDL_DestroySurface(target);
+        return -1;
+    }
+
+    std::vector<BoardResult> results;
+    std::mt19937 gen(42);
+    {
+        // Whole frames through Game::Render
+        auto level1 = NewGame(renderer, 1);
+        results.push_back(Run(GameBoard("board_level1", *level1), options));
+
+        auto level10 = NewGame(renderer, 10);
+        results.push_back(Run(GameBoard("board_level10", *level10), options));
+
+        // Bullets are drawn where they are; nothing moves between frames
+        auto storm = NewGame(renderer, 1);
+        std::uniform_real_distribution<float> x(0.0f, (float)boardWidth);
+        std::uniform_real_distribution<float> y(0.0f, (float)boardHeight);
+        for (int i = 0; i < 600; i++) {
+            storm->GetProjectiles().Spawn(x(gen), y(gen), 0.0f, 0.0f,
+                                          i % 3 ? ProjectileOwner::Enemy : ProjectileOwner::Player);
+        }
+        results.push_back(Run(GameBoard("board_bullet_storm", *storm), options));
+
+        // A volley at the barriers every frame, so each frame uploads the
+        // eroded rows of the barrier textures
+        auto barrage = NewGame(renderer, 1);
+        results.push_back(Run(GameBoard("board_barriers_under_fire", *barrage, [&]() {
+            for (const auto& barrier : barrage->GetBarriers()) {
+                SDL_FRect bounds = barrier->GetBounds();
+                std::uniform_real_distribution<float> bx(bounds.x, bounds.x + bounds.w);
+                barrage->GetProjectiles().Spawn(bx(gen), bounds.y - 10.0f, 0.0f, 300.0f,
+                                                ProjectileOwner::Enemy);
+            }
+            barrage->Update(tickSeconds);
+            if (barrage->IsGameOver()) {
+                barrage->Restart();
+            }
+        }), options));
+
+        // The level 50 formation starts below the invasion line, so one
+        // tick ends the game and shows the overlay and its text
+        auto gameOver = NewGame(renderer, 50);
+        gameOver->Update(tickSeconds);
+        results.push_back(Run(GameBoard("board_game_over", *gameOver), options));
+
+        auto overlay = NewGame(renderer, 1);
+        PressKey(*overlay, SDL_SCANCODE_F3);
+        results.push_back(Run(GameBoard("board_perf_overlay", *overlay, [&]() {
+            overlay->GetProfiler().EndFrame();
+        }), options));
+    }
+
+    {
+        // Graphics::DrawRect alone: one geometry batch of many quads
+        Graphics graphics(renderer);
+        std::vector<SDL_FRect> rects(2000);
+        for (auto& rect : rects) {
+            rect = SDL_FRect{(float)(gen() % boardWidth), (float)(gen() % boardHeight), 30.0f, 30.0f};
+        }
+        results.push_back(Run(Workload{
+            "draw_rect_2000",
+            nullptr,
+            [&]() {
+                graphics.Clear();
+                for (const auto& rect : rects) {
+                    graphics.DrawRect(rect, Color(255, 0, 0), true);
+                }
+                graphics.Present();
+            },
+            [&]() { return graphics.GetLastFrameStats(); }
+        }, options));
+
+        // TextRenderer::DrawText alone: HUD-sized strings from a warm atlas
+        TextRenderer text(&graphics);
+        text.LoadFont(fontPath, 24);
+        results.push_back(Run(Workload{
+            "draw_text_50",
+            nullptr,
+            [&]() {
+                graphics.Clear();
+                for (int i = 0; i < 50; i++) {
+                    text.DrawText("SCORE: 12340   HIGH SCORE: 56780   LEVEL: 9", 400.0f,
+                                  10.0f + i * 11.0f, Color(255, 255, 255), true);
+                }
+                graphics.Present();
+            },
+            [&]() { return graphics.GetLastFrameStats(); }
+        }, options));
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"renderer\": \"software\",\n  \"frames\": " << options.frames
+         << ",\n  \"boards\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BoardResult& r = results[i];
+        json << "    {\"name\": \"" << r.name << "\", \"us_per_frame\": {\"mean\": " << r.meanUS
+             << ", \"p50\": " << r.p50US << ", \"p99\": " << r.p99US << "}, \"draw_calls\": "
+             << r.stats.drawCalls << ", \"state_changes\": " << r.stats.stateChanges
+             << ", \"primitives\": " << r.stats.primitives << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    std::cout << json.str();
+    if (!options.outPath.empty()) {
+        std::ofstream(options.outPath) << json.str();
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return 0;
+}
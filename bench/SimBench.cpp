@@ -0,0 +1,386 @@
+// Simulation benchmark: scripted scenarios stepped headless, reporting
+// ns/tick percentiles as JSON and optionally comparing against a baseline.
+//
+//   invaders_bench [--ticks N] [--warmup N] [--out FILE]
+//                  [--baseline FILE] [--tolerance FRACTION]
+//
+// Each scenario times the full Game::Update, the CheckCollisions pass inside
+// it (from the frame profiler), the enemy movement and firing systems, and the
+// barrier hit test for every bullet in play.
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "Barrier.h"
+#include "UFO.h"
+
+struct BenchOptions {
+    int ticks = 2000;
+    int warmup = 60;
+    std::string outPath;
+    std::string baselinePath;
+    double tolerance = 0.10;  // Allowed p50 slowdown before a metric counts as a regression
+};
+
+struct Scenario {
+    const char* name;
+    // Puts a fresh game into the scenario's starting state
+    std::function<void(Game&)> setup;
+    // Run before every tick, untimed; may top up bullets or rebuild state
+    std::function<void(Game&, std::mt19937&)> beforeTick;
+    // The player fires continuously unless this is cleared
+    bool holdFire = true;
+};
+
+enum Metric {
+    UpdateMetric,
+    CollisionsMetric,
+    EnemyUpdateMetric,
+    BarrierHitMetric,
+    MetricCount
+};
+
+static const char* metricNames[MetricCount] = {
+    "update",
+    "check_collisions",
+    "enemy_update",
+    "barrier_hits"
+};
+
+struct Percentiles {
+    double mean = 0.0;
+    Uint64 p50 = 0;
+    Uint64 p90 = 0;
+    Uint64 p99 = 0;
+    Uint64 max = 0;
+};
+
+struct ScenarioResult {
+    std::string name;
+    Percentiles metrics[MetricCount];
+    double averageEnemies = 0.0;
+    double averageBullets = 0.0;
+    int resets = 0;
+};
+
+static const float tickSeconds = 1.0f / 120.0f;
+
+static Percentiles Summarize(std::vector<Uint64> samples) {
+    Percentiles result;
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double p) { return samples[(size_t)(p * (samples.size() - 1) + 0.5)]; };
+
+    double sum = 0.0;
+    for (Uint64 sample : samples) {
+        sum += (double)sample;
+    }
+    result.mean = sum / samples.size();
+    result.p50 = at(0.50);
+    result.p90 = at(0.90);
+    result.p99 = at(0.99);
+    result.max = samples.back();
+    return result;
+}
+
+static void HoldFire(Game& game) {
+    SDL_Event event{};
+    event.type = SDL_EVENT_KEY_DOWN;
+    event.key.scancode = SDL_SCANCODE_SPACE;
+    game.HandleEvent(event);
+}
+
+static std::unique_ptr<Game> NewGame(const Scenario& scenario) {
+    auto game = std::make_unique<Game>();
+    game->Initialize();
+    if (scenario.holdFire) {
+        HoldFire(*game);
+    }
+    scenario.setup(*game);
+    return game;
+}
+
+static void AdvanceTo(Game& game, int level) {
+    while (game.GetLevel() < level) {
+        game.AdvanceLevel();
+    }
+}
+
+// Keep a number of bullets of each side in play, away from the player so
+// the storm does not end the game every few ticks
+static void TopUpStorm(Game& game, std::mt19937& gen) {
+    const int enemyBullets = 400;
+    const int playerBullets = 200;
+    ProjectilePool& projectiles = game.GetProjectiles();
+    std::uniform_real_distribution<float> x(0.0f, 800.0f);
+
+    while (projectiles.CountOwned(ProjectileOwner::Enemy) < enemyBullets) {
+        float bulletX = x(gen);
+        if (bulletX > 350.0f && bulletX < 450.0f) continue;
+        if (projectiles.Spawn(bulletX, 0.0f, 0.0f, 300.0f, ProjectileOwner::Enemy) < 0) break;
+    }
+    while (projectiles.CountOwned(ProjectileOwner::Player) < playerBullets) {
+        if (projectiles.Spawn(x(gen), 580.0f, 0.0f, -500.0f, ProjectileOwner::Player) < 0) break;
+    }
+}
+
+// Fire a volley at every barrier from both sides each tick, rebuilding the
+// barriers once they are mostly gone
+static void FireAtBarriers(Game& game, std::mt19937& gen) {
+    const int bulletsPerSide = 2;
+    const int initialCells = Barrier::cols * Barrier::rows;
+    ProjectilePool& projectiles = game.GetProjectiles();
+
+    int intact = 0;
+    for (const auto& barrier : game.GetBarriers()) {
+        intact += barrier->CountIntactCells();
+    }
+    if (intact < (int)game.GetBarriers().size() * initialCells / 4) {
+        game.Restart();
+        HoldFire(game);
+    }
+
+    for (const auto& barrier : game.GetBarriers()) {
+        SDL_FRect bounds = barrier->GetBounds();
+        std::uniform_real_distribution<float> x(bounds.x, bounds.x + bounds.w);
+        for (int i = 0; i < bulletsPerSide; i++) {
+            projectiles.Spawn(x(gen), bounds.y - 10.0f, 0.0f, 300.0f, ProjectileOwner::Enemy);
+            projectiles.Spawn(x(gen), bounds.y + bounds.h + 10.0f, 0.0f, -500.0f, ProjectileOwner::Player);
+        }
+    }
+}
+
+static ScenarioResult RunScenario(const Scenario& scenario, const BenchOptions& options) {
+    ScenarioResult result;
+    result.name = scenario.name;
+
+    std::mt19937 gen(42);
+    std::unique_ptr<Game> game = NewGame(scenario);
+
+    std::vector<Uint64> samples[MetricCount];
+    for (auto& metric : samples) {
+        metric.reserve(options.ticks);
+    }
+
+    // Scratch state for the isolated measurements
+    const GameConfig config = game->GetConfig();
+    Enemies scratchEnemies(&config);
+    std::vector<float> fireRolls;
+    std::vector<Barrier> scratchBarriers;
+    std::vector<SDL_FRect> bulletRects;
+    std::vector<float> bulletSpeeds;
+
+    long long enemyTotal = 0;
+    long long bulletTotal = 0;
+
+    for (int tick = -options.warmup; tick < options.ticks; tick++) {
+        if (game->IsGameOver()) {
+            game = NewGame(scenario);
+            result.resets++;
+        }
+        if (scenario.beforeTick) {
+            scenario.beforeTick(*game, gen);
+        }
+        bool measured = tick >= 0;
+
+        // Copy this tick's inputs for the isolated timings
+        scratchEnemies = game->GetEnemies();
+        scratchBarriers.clear();
+        for (const auto& barrier : game->GetBarriers()) {
+            scratchBarriers.push_back(*barrier);
+        }
+        ProjectilePool& projectiles = game->GetProjectiles();
+        bulletRects.clear();
+        bulletSpeeds.clear();
+        for (int i = 0; i < projectiles.Count(); i++) {
+            bulletRects.push_back(projectiles.GetBounds(i));
+            bulletSpeeds.push_back(projectiles.GetVelocity(i).y);
+        }
+
+        // Whole tick. Ending a profiler frame first drops anything the
+        // untimed setup ran, so the next frame holds only this tick.
+        game->GetSimulationProfiler().EndFrame();
+        Uint64 start = SDL_GetTicksNS();
+        game->Update(tickSeconds);
+        Uint64 updateNS = SDL_GetTicksNS() - start;
+        game->GetSimulationProfiler().EndFrame();
+
+        // Enemy movement and firing alone, fire rolls included
+        start = SDL_GetTicksNS();
+        const int enemyCount = scratchEnemies.Count();
+        fireRolls.resize(enemyCount);
+        scratchEnemies.Move(tickSeconds);
+        scratchEnemies.DecideFire(0, enemyCount, tickSeconds, (Uint64)(tick + options.warmup), fireRolls.data());
+        Uint64 enemyNS = SDL_GetTicksNS() - start;
+
+        // Every bullet against the barriers, as Game::HitBarriers does
+        start = SDL_GetTicksNS();
+        for (size_t i = 0; i < bulletRects.size(); i++) {
+            for (auto& barrier : scratchBarriers) {
+                if (barrier.Hit(bulletRects[i], bulletSpeeds[i])) break;
+            }
+        }
+        Uint64 barrierNS = SDL_GetTicksNS() - start;
+
+        if (!measured) continue;
+        samples[UpdateMetric].push_back(updateNS);
+#ifdef INVADERS_PROFILING
+        samples[CollisionsMetric].push_back(
+            game->GetSimulationProfiler().GetFrame(0).phaseNS[(int)FramePhase::Collisions]);
+#endif
+        samples[EnemyUpdateMetric].push_back(enemyNS);
+        samples[BarrierHitMetric].push_back(barrierNS);
+        enemyTotal += (long long)game->GetEnemies().Count();
+        bulletTotal += projectiles.Count();
+    }
+
+    for (int metric = 0; metric < MetricCount; metric++) {
+        result.metrics[metric] = Summarize(samples[metric]);
+    }
+    result.averageEnemies = (double)enemyTotal / options.ticks;
+    result.averageBullets = (double)bulletTotal / options.ticks;
+    return result;
+}
+
+// One scenario per line, so a baseline can be read back without a JSON parser
+static std::string ToJson(const std::vector<ScenarioResult>& results, const BenchOptions& options) {
+    std::ostringstream json;
+    json << "{\n  \"ticks\": " << options.ticks << ",\n  \"tick_seconds\": " << tickSeconds
+         << ",\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const ScenarioResult& r = results[i];
+        json << "    {\"name\": \"" << r.name << "\", \"enemies\": " << r.averageEnemies
+             << ", \"bullets\": " << r.averageBullets << ", \"resets\": " << r.resets;
+        for (int metric = 0; metric < MetricCount; metric++) {
+            const Percentiles& p = r.metrics[metric];
+            json << ", \"" << metricNames[metric] << "\": ";
+#ifndef INVADERS_PROFILING
+            if (metric == CollisionsMetric) {
+                json << "null";
+                continue;
+            }
+#endif
+            json << "{\"mean_ns\": " << (Uint64)p.mean << ", \"p50_ns\": " << p.p50
+                 << ", \"p90_ns\": " << p.p90 << ", \"p99_ns\": " << p.p99
+                 << ", \"max_ns\": " << p.max << "}";
+        }
+        json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+// p50 of metric for the scenario on this line of a previous report; -1 if absent
+static double ReadBaselineP50(const std::string& line, const char* metric) {
+    std::string key = std::string("\"") + metric + "\": {";
+    size_t at = line.find(key);
+    if (at == std::string::npos) return -1.0;
+    at = line.find("\"p50_ns\": ", at);
+    if (at == std::string::npos) return -1.0;
+    return std::atof(line.c_str() + at + 10);
+}
+
+// Returns the number of regressions found
+static int CompareWithBaseline(const std::vector<ScenarioResult>& results, const BenchOptions& options) {
+    std::ifstream file(options.baselinePath);
+    if (!file) {
+        std::cerr << "Unable to read baseline " << options.baselinePath << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+
+    int regressions = 0;
+    for (const ScenarioResult& r : results) {
+        std::string key = "\"name\": \"" + r.name + "\"";
+        auto line = std::find_if(lines.begin(), lines.end(),
+            [&](const std::string& l) { return l.find(key) != std::string::npos; });
+        if (line == lines.end()) {
+            std::cerr << r.name << ": not in baseline" << std::endl;
+            continue;
+        }
+
+        for (int metric = 0; metric < MetricCount; metric++) {
+            double before = ReadBaselineP50(*line, metricNames[metric]);
+            double after = (double)r.metrics[metric].p50;
+            if (before <= 0.0 || after <= 0.0) continue;
+
+            double change = after / before - 1.0;
+            bool regressed = change > options.tolerance;
+            std::cerr << r.name << " " << metricNames[metric] << ": p50 " << (Uint64)before
+                      << " -> " << (Uint64)after << " ns (" << (change >= 0.0 ? "+" : "")
+                      << (int)(change * 100.0) << "%)" << (regressed ? "  REGRESSION" : "") << std::endl;
+            if (regressed) regressions++;
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--ticks" && i + 1 < argc) options.ticks = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && i + 1 < argc) options.warmup = std::atoi(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) options.outPath = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) options.baselinePath = argv[++i];
+        else if (arg == "--tolerance" && i + 1 < argc) options.tolerance = std::atof(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--ticks N] [--warmup N] [--out FILE]"
+                      << " [--baseline FILE] [--tolerance FRACTION]" << std::endl;
+            return -1;
+        }
+    }
+    if (options.ticks <= 0 || options.warmup < 0) {
+        std::cerr << "--ticks must be positive" << std::endl;
+        return -1;
+    }
+
+    const std::vector<Scenario> scenarios = {
+        {"formation_level1", [](Game&) {}, nullptr},
+        {"formation_level10", [](Game& game) { AdvanceTo(game, 10); }, nullptr},
+        // The level 50 formation starts below the invasion line, so every
+        // tick is the first tick of a fresh game
+        {"formation_level50", [](Game& game) { AdvanceTo(game, 50); }, nullptr},
+        {"bullet_storm", [](Game&) {}, TopUpStorm},
+        {"barriers_under_fire", [](Game&) {}, FireAtBarriers},
+        // Only ticks with the UFO on screen are measured. The player holds
+        // fire so the UFO survives to make more passes.
+        {"ufo_pass", [](Game&) {}, [](Game& game, std::mt19937&) {
+            while (!game.GetUFO()->IsActive() && !game.IsGameOver()) {
+                game.Update(tickSeconds);
+            }
+        }, false},
+    };
+
+    std::vector<ScenarioResult> results;
+    for (const Scenario& scenario : scenarios) {
+        std::cerr << "Running " << scenario.name << "..." << std::endl;
+        results.push_back(RunScenario(scenario, options));
+    }
+
+    std::string json = ToJson(results, options);
+    std::cout << json;
+    if (!options.outPath.empty()) {
+        std::ofstream(options.outPath) << json;
+    }
+
+    if (!options.baselinePath.empty()) {
+        return CompareWithBaseline(results, options) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// Target boxes packed as separate min/max arrays so that one box can be tested
+// against a whole block of them with SIMD. Storage is always padded to a
+// multiple of AabbBatch::blockSize with empty boxes that never overlap.
+class AabbBatch {
+public:
+    static constexpr int blockSize = 16;
+
+    void Clear();
+    // Returns the index of the new box
+    int Add(const SDL_FRect& rect);
+    // Copy box index of another batch without converting back to a rect
+    int Add(const AabbBatch& other, int index);
+    int Count() const { return count; }
+    int BlockCount() const { return (count + blockSize - 1) / blockSize; }
+
+    const float* MinX() const { return minX.data(); }
+    const float* MinY() const { return minY.data(); }
+    const float* MaxX() const { return maxX.data(); }
+    const float* MaxY() const { return maxY.data(); }
+
+private:
+    int count = 0;
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+
+    int Append();
+};
+
+enum class AabbKernel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Tests box against targets [first, first + 16) of batch; bit i of the result
+// is set when target first + i overlaps. Overlap matches
+// SDL_HasRectIntersectionFloat: touching edges count, and a rect with negative
+// width or height is empty. The raw kernels assume box is not empty.
+using AabbOverlapFn = uint32_t (*)(const SDL_FRect& box, const AabbBatch& batch, int first);
+
+// Best kernel the running CPU supports, detected once
+AabbKernel DetectAabbKernel();
+// Null if the kernel is not compiled for this architecture or the CPU lacks it
+AabbOverlapFn GetAabbKernel(AabbKernel kernel);
+const char* GetAabbKernelName(AabbKernel kernel);
+
+// Dispatches to the detected kernel
+uint32_t OverlapMask16(const SDL_FRect& box, const AabbBatch& batch, int first);
+
+// Calls visit(index) for every box in batch that overlaps box, in index
+// order. visit returns true to stop early.
+template <typename Visitor>
+void ForEachOverlap(const SDL_FRect& box, const AabbBatch& batch, Visitor&& visit) {
+    for (int block = 0; block < batch.BlockCount(); block++) {
+        int first = block * AabbBatch::blockSize;
+        uint32_t hits = OverlapMask16(box, batch, first);
+        while (hits != 0) {
+            int index = first + std::countr_zero(hits);
+            hits &= hits - 1;
+            if (index < batch.Count() && visit(index)) {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "BinaryStream.h"
+
+// Refers to one entity of an Archetype. A slot's generation goes up every
+// time its entity is removed, so a handle to a removed entity never
+// resolves again, even once the slot is reused.
+struct EntityHandle {
+    uint32_t index = ~0u;
+    uint32_t generation = 0;
+
+    bool operator==(const EntityHandle&) const = default;
+};
+
+// Every entity with the same set of components, stored as one dense array
+// per component. Rows are packed: removing one moves the last row into the
+// hole (swap-and-pop), so row numbers only hold until the next removal.
+// Keep an EntityHandle to follow an entity across removals. Components are
+// looked up by type, so each type may appear only once.
+template <typename... Components>
+class Archetype {
+    static_assert((std::is_trivially_copyable_v<Components> && ...), "components must be plain data");
+
+public:
+    // Appends a row and returns its handle
+    EntityHandle Create(const Components&... values) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = (uint32_t)generations.size();
+            generations.push_back(0);
+            rowOfSlot.push_back(0);
+        }
+
+        rowOfSlot[slot] = (uint32_t)slotOfRow.size();
+        slotOfRow.push_back(slot);
+        (Column<Components>().push_back(values), ...);
+        return EntityHandle{slot, generations[slot]};
+    }
+
+    bool Remove(EntityHandle handle) {
+        int row = RowOf(handle);
+        if (row < 0) {
+            return false;
+        }
+        RemoveRow(row);
+        return true;
+    }
+
+    // The last row moves into row
+    void RemoveRow(int row) {
+        const int last = Count() - 1;
+        const uint32_t slot = slotOfRow[row];
+        if (row != last) {
+            (MoveRow<Components>(last, row), ...);
+            slotOfRow[row] = slotOfRow[last];
+            rowOfSlot[slotOfRow[row]] = (uint32_t)row;
+        }
+        (Column<Components>().pop_back(), ...);
+        slotOfRow.pop_back();
+
+        generations[slot]++;
+        freeSlots.push_back(slot);
+    }
+
+    // Removes every row for which remove(row) is true, moving rows as
+    // RemoveRow does. Returns how many were removed.
+    template <typename Predicate>
+    int RemoveIf(Predicate&& remove) {
+        int removed = 0;
+        int row = 0;
+        while (row < Count()) {
+            if (remove(row)) {
+                // The last row moves into this one and is checked next
+                RemoveRow(row);
+                removed++;
+            } else {
+                row++;
+            }
+        }
+        return removed;
+    }
+
+    void Clear() {
+        while (Count() > 0) {
+            RemoveRow(Count() - 1);
+        }
+    }
+
+    void Reserve(int capacity) {
+        (Column<Components>().reserve(capacity), ...);
+        slotOfRow.reserve(capacity);
+        rowOfSlot.reserve(capacity);
+        generations.reserve(capacity);
+        freeSlots.reserve(capacity);
+    }
+
+    int Count() const { return (int)slotOfRow.size(); }
+
+    // Row of a live entity, or -1
+    int RowOf(EntityHandle handle) const {
+        if (handle.index >= generations.size() || generations[handle.index] != handle.generation) {
+            return -1;
+        }
+        return (int)rowOfSlot[handle.index];
+    }
+    bool Contains(EntityHandle handle) const { return RowOf(handle) >= 0; }
+    EntityHandle HandleAt(int row) const {
+        uint32_t slot = slotOfRow[row];
+        return EntityHandle{slot, generations[slot]};
+    }
+
+    // The whole column of one component, indexed by row
+    template <typename T>
+    T* Data() { return Column<T>().data(); }
+    template <typename T>
+    const T* Data() const { return Column<T>().data(); }
+
+    template <typename T>
+    T& Get(int row) { return Column<T>()[row]; }
+    template <typename T>
+    const T& Get(int row) const { return Column<T>()[row]; }
+
+    // Bytes one row of every column takes
+    static constexpr size_t rowSize = (sizeof(Components) + ...);
+
+    // Every column as it is in memory, without the row count. Handles are
+    // not saved: Load creates fresh ones, so handles taken before it no
+    // longer resolve afterwards.
+    void Save(BinaryWriter& writer) const {
+        (writer.WriteBytes(Column<Components>().data(), Count() * sizeof(Components)), ...);
+    }
+
+    // Replaces every row with count rows written by Save. Leaves the
+    // archetype unchanged if the data is short.
+    bool Load(BinaryReader& reader, int count) {
+        const uint8_t* bytes = count >= 0 ? reader.Skip(count * rowSize) : nullptr;
+        if (!bytes) {
+            return false;
+        }
+
+        Clear();
+        for (int row = 0; row < count; row++) {
+            Create(Components{}...);
+        }
+        ((std::memcpy(Column<Components>().data(), bytes, count * sizeof(Components)),
+          bytes += count * sizeof(Components)), ...);
+        return true;
+    }
+
+private:
+    std::tuple<std::vector<Components>...> columns;
+    std::vector<uint32_t> slotOfRow;    // Row -> slot
+    std::vector<uint32_t> rowOfSlot;    // Slot -> row, while the slot is live
+    std::vector<uint32_t> generations;  // Slot -> generation of its current or next entity
+    std::vector<uint32_t> freeSlots;
+
+    template <typename T>
+    std::vector<T>& Column() { return std::get<std::vector<T>>(columns); }
+    template <typename T>
+    const std::vector<T>& Column() const { return std::get<std::vector<T>>(columns); }
+
+    template <typename T>
+    void MoveRow(int from, int to) {
+        std::vector<T>& column = Column<T>();
+        column[to] = column[from];
+    }
+};
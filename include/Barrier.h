@@ -1,35 +1,51 @@
 #pragma once
 #include <SDL3/SDL.h>
-#include <vector>
-#include "Graphics.h"
+#include <cstdint>
 
-// A barrier consists of multiple "bricks" that can be individually destroyed
+// A barrier is a bit mask of 2x2 pixel cells, one 64-bit word per row. Hits
+// are found by masking the rows under a bullet and erode a crater stamp, as
+// in the arcade original.
 class Barrier {
 public:
-    Barrier(Graphics* graphics, float x, float y);
-    ~Barrier();
+    static constexpr int cellSize = 2;   // Pixels per cell side
+    static constexpr int cols = 40;      // 80 px wide
+    static constexpr int rows = 30;      // 60 px high
+    static constexpr float width = cols * cellSize;
+    static constexpr float height = rows * cellSize;
 
-    void Update(float deltaTime);
-    void Render();
-    
-    struct Brick {
-        SDL_FRect rect;
-        bool destroyed = false;
+    // Everything that changes during play, for snapshots
+    struct State {
+        SDL_FPoint position;
+        uint64_t cells[rows];
     };
-    
-    const std::vector<Brick>& GetBricks() const { return bricks; }
-    void DamageBrick(int index);
+
+    Barrier(float x, float y);
+
+    void Update(float deltaTime);
+
+    // If rect overlaps an intact cell, blast a crater where a bullet travelling
+    // with vertical velocity vy would first touch the barrier and return true
+    bool Hit(const SDL_FRect& rect, float vy);
+    bool Overlaps(const SDL_FRect& rect) const;
+
     SDL_FPoint GetPosition() const { return position; }
-    
+    SDL_FRect GetBounds() const { return BoundsAt(position); }
+    // Bounds of a barrier centered on position
+    static SDL_FRect BoundsAt(SDL_FPoint position) {
+        return SDL_FRect{position.x - width * 0.5f, position.y - height * 0.5f, width, height};
+    }
+    int CountIntactCells() const;
+
+    State GetState() const;
+    void SetState(const State& state);
+
 private:
-    Graphics* graphics;
     SDL_FPoint position{0.0f, 0.0f};
-    
-    float width = 80.0f;
-    float height = 60.0f;
-    float brickSize = 10.0f;  // Size of individual bricks
-    
-    std::vector<Brick> bricks;
-    
-    void CreateBricks();
+
+    uint64_t cells[rows];  // Bit c of cells[r] is set while cell (c, r) is intact
+
+    void CreateCells();
+    // Cell range under rect, clipped to the barrier; false if there is none
+    bool CellRange(const SDL_FRect& rect, int& col0, int& row0, int& col1, int& row1) const;
+    void Erode(int col, int row);
 };
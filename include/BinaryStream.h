@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Appends values to a byte buffer in the machine's native layout. Files
+// written with it are only read back on the same kind of machine.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be written");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    // Seven bits per byte, lowest first; small values take one byte
+    void WriteVarint(uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    size_t Size() const { return out.size(); }
+
+private:
+    std::vector<uint8_t>& out;
+};
+
+// Reads what BinaryWriter wrote. Any read past the end fails, and so does
+// every read after it.
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be read");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBytes(void* destination, size_t count) {
+        const uint8_t* bytes = Skip(count);
+        if (!bytes) {
+            return false;
+        }
+        std::memcpy(destination, bytes, count);
+        return true;
+    }
+
+    bool ReadVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!Read(byte)) {
+                return false;
+            }
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        failed = true;
+        return false;
+    }
+
+    // Returns the next count bytes in place and moves past them, or null
+    const uint8_t* Skip(size_t count) {
+        if (failed || count > size - offset) {
+            failed = true;
+            return nullptr;
+        }
+        const uint8_t* bytes = data + offset;
+        offset += count;
+        return bytes;
+    }
+
+    size_t Offset() const { return offset; }
+    bool AtEnd() const { return offset == size; }
+    bool Failed() const { return failed; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+};
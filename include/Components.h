@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+
+// Component types stored by the archetypes (see Archetype.h). An archetype
+// finds its columns by type, so each component is its own type even where
+// two have the same shape. All are plain data, saved to snapshots byte for
+// byte, so any padding is spelled out and zeroed.
+
+struct Position {
+    float x, y;
+};
+
+// Position at the start of the last tick, for interpolated drawing
+struct PreviousPosition {
+    float x, y;
+};
+
+// Cell of the invader grid (see Formation.h)
+struct FormationCell {
+    int column, row;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+// Cleared when the entity is hit; the owner removes it later in the tick
+struct Alive {
+    uint8_t value;
+};
+
+// The entity's counter-based random stream (see Random.h)
+struct RandomStream {
+    Uint64 id;
+};
+
+struct Weapon {
+    float cooldown;          // Seconds until it may fire again
+    uint8_t fireRequested;   // Set by the firing decision, cleared when the shot spawns
+    uint8_t padding[3];
+};
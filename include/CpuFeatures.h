@@ -0,0 +1,17 @@
+#pragma once
+
+// x86 SIMD support shared by the batch kernels. Kernels for newer
+// instruction sets are compiled with a per-function target attribute and
+// only called after checking the running CPU.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define INVADERS_HAVE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define INVADERS_TARGET_AVX2
+#else
+#define INVADERS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// True when the CPU has AVX2 and the OS saves the YMM state
+bool CpuHasAVX2();
+#endif
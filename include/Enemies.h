@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "Archetype.h"
+#include "Components.h"
+#include "GameConfig.h"
+#include "Formation.h"
+
+class ProjectilePool;
+
+// Every invader, stored as one archetype and placed on one Formation grid.
+// The firing decision runs over a range of rows, so it can be spread across
+// threads; Fire, which spawns into the shared projectile pool, runs alone.
+class Enemies {
+public:
+    using Store = Archetype<FormationCell, Weapon, RandomStream>;
+
+    // Every invader has the same size
+    static constexpr float width = 30.0f;
+    static constexpr float height = 30.0f;
+    static constexpr float shootProbability = 0.0005f;
+
+    explicit Enemies(const GameConfig* config);
+
+    // Replace every enemy with a full columns x rows formation. Enemies take
+    // the random streams from firstStream up, one each in row-major order.
+    void Form(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing, Uint64 firstStream);
+    // Remove every enemy and the formation with them
+    void Clear();
+
+    // Moves the whole formation
+    void Move(float deltaTime) { formation.Step(deltaTime); }
+    // Firing decision: count down cooldowns and roll each enemy's draw for
+    // tick; only the front line may fire. rolls is scratch space for
+    // end - begin draws.
+    void DecideFire(int begin, int end, float deltaTime, Uint64 tick, float* rolls);
+    // Spawn the bullets DecideFire asked for, in row order
+    void Fire(ProjectilePool& projectiles);
+
+    // The row of the alive enemy bounds overlaps, lowest in the formation
+    // first, or -1
+    int FindHit(const SDL_FRect& bounds) const;
+    // Take an enemy out of the formation; RemoveDead drops its row
+    void Kill(int row) {
+        const FormationCell& cell = store.Get<FormationCell>(row);
+        formation.Kill(cell.column, cell.row);
+    }
+    // Swap-and-pop every enemy killed since the last call
+    void RemoveDead();
+
+    int Count() const { return store.Count(); }
+    bool IsAlive(int row) const {
+        const FormationCell& cell = store.Get<FormationCell>(row);
+        return formation.IsAlive(cell.column, cell.row);
+    }
+    SDL_FPoint GetPosition(int row) const {
+        const FormationCell& cell = store.Get<FormationCell>(row);
+        SDL_FPoint position = formation.GetCellPosition(cell.column, cell.row);
+        SDL_FPoint offset = formation.GetOffset();
+        return SDL_FPoint{position.x + offset.x, position.y + offset.y};
+    }
+    SDL_FRect GetBounds(int row) const {
+        SDL_FPoint position = GetPosition(row);
+        return SDL_FRect{position.x - width * 0.5f, position.y - height * 0.5f, width, height};
+    }
+    const Formation& GetFormation() const { return formation; }
+
+    // The components, for snapshots and tools. After loading rows into the
+    // store, restore the formation they belong to with RestoreFormation.
+    Store& GetStore() { return store; }
+    const Store& GetStore() const { return store; }
+    void RestoreFormation(const Formation::State& state);
+
+private:
+    const GameConfig* config;
+    Store store;
+    Formation formation;
+    std::vector<EntityHandle> cellHandles;  // Enemy in each grid cell, row-major
+
+    // Point every cell at the enemy now in it
+    void LinkCells();
+};
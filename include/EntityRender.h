@@ -0,0 +1,20 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "RenderSnapshot.h"
+
+class Graphics;
+
+// Entity drawing, from a RenderSnapshot rather than the live entities.
+// alpha is how far the frame is into the next tick (0..1); moving things are
+// drawn between their previous and current positions.
+void DrawPlayer(Graphics& graphics, const SpriteFrame& player, float alpha);
+void DrawEnemies(Graphics& graphics, const std::vector<SDL_FPoint>& cells, const SpriteFrame& offset, float alpha);
+void DrawProjectiles(Graphics& graphics, const std::vector<SpriteFrame>& projectiles, float alpha);
+void DrawUFO(Graphics& graphics, const SpriteFrame& ufo, float alpha);
+// Bring texture, which must be Barrier::cols x Barrier::rows RGBA8888 and
+// hold the cells of uploaded, up to date with barrier. Only rows that differ
+// from uploaded are sent, and uploaded is updated to match. Returns false if
+// nothing changed, else the changed rows in top..bottom.
+bool UploadBarrier(SDL_Texture* texture, const Barrier::State& barrier, Barrier::State& uploaded,
+                   int& top, int& bottom);
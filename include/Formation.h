@@ -0,0 +1,97 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+#include "Components.h"
+
+// The invader grid. Enemies sit on a regular lattice of cells and move as
+// one unit: each is drawn at its cell plus the shared offset, so a tick is
+// one step and one edge test for the whole grid. Which cells are alive is a
+// bit mask per row, and the front line (the lowest alive row of each column)
+// is kept up to date as enemies die, so hit tests, the edge test and the
+// invasion check never walk every enemy.
+class Formation {
+public:
+    // Everything that changes during play, for snapshots. The alive masks
+    // and front line are rebuilt from the enemies on load.
+    struct State {
+        SDL_FPoint offset;
+        SDL_FPoint previousOffset;  // Offset at the start of the last tick
+        float direction;            // 1 moving right, -1 moving left
+        SDL_FPoint origin;          // Center of cell (0, 0), before the offset
+        SDL_FPoint spacing;
+        int columns;
+        int rows;
+        int alive;
+        // Extent of the alive cells, refit on every kill
+        int firstColumn;
+        int lastColumn;
+        int bottomRow;
+    };
+
+    static constexpr float moveSpeed = 50.0f;   // With every enemy alive
+    static constexpr float maxSpeedUp = 4.0f;   // Speed multiplier with one enemy left
+    static constexpr float dropAmount = 15.0f;
+
+    // Every cell holds an enemy of cellWidth x cellHeight
+    Formation(const GameConfig* config, float cellWidth, float cellHeight);
+
+    // No cells, back at offset zero and heading right
+    void Clear();
+    // A columns x rows grid with every cell alive, at offset zero and heading right
+    void Form(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing);
+    // Empty one cell; the front line and alive extent follow
+    void Kill(int column, int row);
+
+    // Move sideways, and drop and turn back once the alive cells reach an edge
+    void Step(float deltaTime);
+
+    // The alive cell whose enemy overlaps bounds, lowest row first. Maps the
+    // box onto the lattice, so it only looks at the cells under it.
+    bool FindHit(const SDL_FRect& bounds, int& column, int& row) const;
+
+    bool IsAlive(int column, int row) const {
+        return (aliveMasks[row * wordsPerRow + column / 64] >> (column % 64)) & 1;
+    }
+    // Row of the column's lowest alive enemy, or -1 once the column is empty
+    int GetFrontRow(int column) const { return frontRows[column]; }
+    int GetAliveCount() const { return state.alive; }
+
+    // Center of a cell, before the offset
+    SDL_FPoint GetCellPosition(int column, int row) const {
+        return SDL_FPoint{state.origin.x + column * state.spacing.x, state.origin.y + row * state.spacing.y};
+    }
+    // Center of the lowest alive enemy; meaningless once none are left
+    float GetBottom() const { return state.origin.y + state.bottomRow * state.spacing.y + state.offset.y; }
+
+    SDL_FPoint GetOffset() const { return state.offset; }
+    // Offset to draw at, blended between the last two ticks
+    SDL_FPoint GetOffset(float alpha) const {
+        return SDL_FPoint{
+            state.previousOffset.x + (state.offset.x - state.previousOffset.x) * alpha,
+            state.previousOffset.y + (state.offset.y - state.previousOffset.y) * alpha
+        };
+    }
+    float GetSpeed() const;
+
+    const State& GetState() const { return state; }
+    // cells lists every alive cell of the saved formation; any outside its
+    // grid are ignored
+    void SetState(const State& newState, const FormationCell* cells, int count);
+
+private:
+    const GameConfig* config;
+    float cellWidth;
+    float cellHeight;
+    State state;
+
+    int wordsPerRow = 0;
+    std::vector<uint64_t> aliveMasks;  // wordsPerRow per row; column c is bit c % 64 of word c / 64
+    std::vector<int> frontRows;        // Per column
+
+    // Resize the masks and front line for the state's grid, every cell empty
+    void Allocate();
+    // The alive extent from the front line
+    void Refit();
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+// How evenly frames were delivered since the pacer was created
+struct FramePacingStats {
+    long long frames = 0;       // Intervals measured
+    double meanMS = 0.0;        // Mean time between frames
+    double jitterMS = 0.0;      // Standard deviation of the time between frames
+    double worstErrorMS = 0.0;  // Largest distance of one interval from the target
+    long long missed = 0;       // Frames delivered over half a period after their deadline
+    double sleptMS = 0.0;       // Total time spent asleep in Wait
+    double spunMS = 0.0;        // Total time spent spinning in Wait
+};
+
+// Holds the render loop to a target frame rate. Wait sleeps until shortly
+// before the frame's deadline and spins on the nanosecond clock for the
+// rest, since a sleep can overshoot by a millisecond or more. The spin
+// margin follows the worst recent oversleep. Deadlines advance by one
+// period, so a late frame does not push back the ones after it; a frame
+// more than a period late starts the schedule again rather than bursting.
+class FramePacer {
+public:
+    static constexpr Uint64 minSpinNS = 200 * 1000;
+    static constexpr Uint64 maxSpinNS = 4 * SDL_NS_PER_MS;
+
+    // A targetFPS of 0 paces nothing: Wait only measures
+    explicit FramePacer(int targetFPS);
+
+    // Call once per frame, after presenting
+    void Wait();
+
+    Uint64 GetPeriodNS() const { return periodNS; }
+    FramePacingStats GetStats() const;
+
+private:
+    Uint64 periodNS;
+    Uint64 deadline = 0;
+    Uint64 lastFrame = 0;          // When the previous Wait returned
+    Uint64 spinNS = SDL_NS_PER_MS;
+
+    long long frames = 0;
+    long long missed = 0;
+    double intervalSum = 0.0;      // In nanoseconds
+    double intervalSquares = 0.0;
+    double worstError = 0.0;
+    Uint64 sleptNS = 0;
+    Uint64 spunNS = 0;
+
+    // Sleep until spinNS before deadline, then adjust spinNS to the overshoot
+    void Sleep(Uint64 now);
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <array>
+
+// The parts of a frame that are timed separately
+enum class FramePhase {
+    Events,
+    Update,
+    Collisions,
+    Render,
+    Present,
+    Count
+};
+
+constexpr int framePhaseCount = (int)FramePhase::Count;
+
+const char* GetFramePhaseName(FramePhase phase);
+
+struct FrameTiming {
+    Uint64 frameNS = 0;                      // Wall time since the previous frame ended
+    Uint64 phaseNS[framePhaseCount] = {};    // Time spent in each phase, nested phases excluded
+};
+
+class ScopedPhaseTimer;
+
+// Per-phase timings for the last historySize frames. Phases are timed with
+// PROFILE_PHASE; a phase that runs several times in a frame (Update during
+// catch-up) accumulates.
+class FrameProfiler {
+public:
+    static constexpr int historySize = 240;
+
+    void Add(FramePhase phase, Uint64 ns) { current.phaseNS[(int)phase] += ns; }
+    // Close the current frame and start timing the next one
+    void EndFrame();
+    // Hand over the phase times added since the last EndFrame or TakeCurrent
+    // and start again from zero, for timings that belong to another
+    // profiler's frames
+    FrameTiming TakeCurrent();
+
+    int FrameCount() const { return count; }
+    // age 0 is the most recent complete frame
+    const FrameTiming& GetFrame(int age) const;
+
+private:
+    friend class ScopedPhaseTimer;
+
+    std::array<FrameTiming, historySize> history{};
+    int next = 0;
+    int count = 0;
+    FrameTiming current;
+    Uint64 lastFrameEnd = 0;
+    ScopedPhaseTimer* activeTimer = nullptr;  // Innermost running timer
+};
+
+// Adds the time between construction and destruction to a phase. Time spent
+// in timers nested inside it is charged to their own phases instead.
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(FrameProfiler& profiler, FramePhase phase)
+        : profiler(profiler), phase(phase), parent(profiler.activeTimer), start(SDL_GetTicksNS()) {
+        profiler.activeTimer = this;
+    }
+
+    ~ScopedPhaseTimer() {
+        Uint64 elapsed = SDL_GetTicksNS() - start;
+        profiler.Add(phase, elapsed - childNS);
+        if (parent) {
+            parent->childNS += elapsed;
+        }
+        profiler.activeTimer = parent;
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    FrameProfiler& profiler;
+    FramePhase phase;
+    ScopedPhaseTimer* parent;
+    Uint64 start;
+    Uint64 childNS = 0;
+};
+
+// Time the rest of the enclosing scope. Compiles to nothing unless the build
+// defines INVADERS_PROFILING.
+#ifdef INVADERS_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_PHASE(profiler, phase) \
+    ScopedPhaseTimer PROFILE_CONCAT(phaseTimer, __LINE__)((profiler), (phase))
+#else
+#define PROFILE_PHASE(profiler, phase) ((void)0)
+#endif
@@ -3,38 +3,145 @@
 #include <memory>
 #include <vector>
 #include <string>
-#include "Graphics.h" // For Color type
-#include "TextRenderer.h" // Font-based TextRenderer
+#include "AabbBatch.h"
+#include "ProjectilePool.h"
+#include "Enemies.h"
+#include "FrameProfiler.h"
+#include "GameConfig.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
 
 // Forward declarations
+class Graphics;
+class TextRenderer;
+class PerfOverlay;
+class Hud;
 class Player;
-class Enemy;
-class Bullet;
 class Barrier;
 class UFO;
+class ReplayRecorder;
 
 class Game {
 public:
-    Game(SDL_Window* window, SDL_Renderer* renderer);
+    // Headless game: simulation only, Render() and Draw() must not be called
+    Game(const GameConfig& config = GameConfig());
+    // Windowed game: creates the render-side objects (defined in src/Render)
+    Game(SDL_Window* window, SDL_Renderer* renderer, const GameConfig& config = GameConfig());
     ~Game();
 
     void Initialize();
     void HandleEvent(const SDL_Event& event);
     void Update(float deltaTime);
-    void Render();
+    // Capture a snapshot and draw it, for callers that simulate and render
+    // on one thread. alpha is how far the wall clock has advanced into the
+    // next tick (0..1); moving entities are drawn between their previous and
+    // current positions.
+    void Render(float alpha = 1.0f);
+
+    // Copy what the next frame draws into frame, reusing its storage. Runs on
+    // the thread that calls Update.
+    void CaptureRenderSnapshot(RenderSnapshot& frame);
+    // Draw and present frame. Touches only frame and the render-side
+    // objects, so it may run on another thread while Update does.
+    void Draw(const RenderSnapshot& frame, float alpha);
+    // Repaint the whole static layer on the next Draw, e.g. after the
+    // renderer lost its render targets. Call on the thread that draws.
+    void InvalidateStaticLayer() { staticLayerValid = false; }
+
+    // Start over from level 1, keeping the high score
+    void Restart();
+    // Replace the formation with the next level's, as if it had been cleared
+    void AdvanceLevel();
+
+    // Record every key event, restart and keyframe into recorder from now
+    // on; null stops recording. The recorder must outlive the game.
+    void SetRecorder(ReplayRecorder* replayRecorder) { recorder = replayRecorder; }
+
+    // The whole simulation state as one flat, versioned blob: a header with
+    // a section table, then every entity's state and component columns exactly
+    // as they are in memory.
+    // LoadSnapshot leaves the game untouched and returns false if data is
+    // not a snapshot of a game with the same layout and seed.
+    void SaveSnapshot(std::vector<Uint8>& out) const;
+    bool LoadSnapshot(const Uint8* data, size_t size);
+    // Writes the snapshot through a memory-mapped file; load one by mapping
+    // it with MappedFile and passing the view to LoadSnapshot
+    bool SaveSnapshotFile(const std::string& path) const;
+    // The config a snapshot was taken with, to create a game that can load it
+    static bool ReadSnapshotConfig(const Uint8* data, size_t size, GameConfig& snapshotConfig);
+
+    bool IsHeadless() const { return renderer == nullptr; }
+    bool IsGameOver() const { return gameOver; }
+    int GetScore() const { return score; }
+    int GetLevel() const { return level; }
+    // Number of Update calls so far
+    Uint64 GetTick() const { return tick; }
+    const GameConfig& GetConfig() const { return config; }
+    // Null when headless
+    Graphics* GetGraphics() const { return graphics.get(); }
+    // Phase timings shown by the F3 overlay; the main loop ends each frame.
+    // Update and Collisions times reach it through the snapshots drawn.
+    FrameProfiler& GetProfiler() { return profiler; }
+    // Update and Collisions times, on the thread that calls Update. Each
+    // snapshot capture takes what has accumulated.
+    FrameProfiler& GetSimulationProfiler() { return simulationProfiler; }
+
+    // Direct access to the simulation state for benchmarks and tools
+    ProjectilePool& GetProjectiles() { return projectiles; }
+    const ProjectilePool& GetProjectiles() const { return projectiles; }
+    const Enemies& GetEnemies() const { return enemies; }
+    const std::vector<std::unique_ptr<Barrier>>& GetBarriers() const { return barriers; }
+    const UFO* GetUFO() const { return ufo.get(); }
 
 private:
-    SDL_Window* window;
-    SDL_Renderer* renderer;
-    
+    // Declared first: the members below are sized from it
+    GameConfig config;
+
+    SDL_Window* window = nullptr;
+    SDL_Renderer* renderer = nullptr;
+
+    // Render-side objects, null when headless. Held by shared_ptr so that the
+    // simulation library can destroy a Game without linking the renderer.
+    std::shared_ptr<Graphics> graphics;
+    std::shared_ptr<TextRenderer> textRenderer;
+    std::shared_ptr<Hud> hud;
+    // Texture handles for the barriers and the cells each one holds,
+    // indexed like RenderSnapshot::barriers
+    std::vector<Uint32> barrierTextures;
+    std::vector<Barrier::State> uploadedBarriers;
+    // Field-sized render target holding everything that does not move: the
+    // background and the barriers. Only the rows of barriers that changed
+    // are repainted; each frame then draws it with one texture call.
+    Uint32 staticLayer = 0;
+    bool staticLayerValid = false;
+    size_t layerBarriers = 0;  // Barriers painted by the last full repaint
+    std::shared_ptr<PerfOverlay> perfOverlay;
+    bool showPerfOverlay = false;
+
+    FrameProfiler profiler;
+    FrameProfiler simulationProfiler;
+
+    // Snapshot for Render() to draw
+    RenderSnapshot renderFrame;
+    Uint64 capturedFrames = 0;   // Snapshots captured so far, for their sequence numbers
+    Uint64 drawnSequence = 0;    // Newest snapshot whose simulation times were counted
+
     std::unique_ptr<Player> player;
-    std::vector<std::unique_ptr<Enemy>> enemies;
+    Enemies enemies{&config};
     std::vector<std::unique_ptr<Barrier>> barriers;
     std::unique_ptr<UFO> ufo;
-    
-    // Text renderer
-    std::unique_ptr<TextRenderer> textRenderer;
-    
+
+    // Spreads large formations and bullet counts across threads
+    JobSystem jobs{config.workerThreads};
+    static constexpr int enemyGrain = 256;       // Fewer enemies than this update inline
+    static constexpr int projectileGrain = 1024;
+    Uint64 nextEntityId = 0;  // Random stream of the next enemy or UFO
+    Uint64 tick = 0;          // Update calls so far; the counter for per-tick random draws
+    std::vector<float> fireRolls;
+
+    // Every bullet in play, whoever fired it
+    ProjectilePool projectiles{config.projectileCapacity, config.fieldWidth, config.fieldHeight};
+
     float gameTime = 0.0f;
 
     // Game state
@@ -42,13 +149,26 @@ private:
     int score = 0;
     int highScore = 0;
     int level = 1;
-    
+
     // Game parameters
     const float enemySpawnTime = 5.0f;
     float enemySpawnTimer = 0.0f;
 
+    // Packed boxes for the SIMD overlap kernel, rebuilt every tick
+    AabbBatch projectileBoxes;  // Indexed like projectiles
+
+    ReplayRecorder* recorder = nullptr;
+
+    // The board as Initialize left it; restarting restores it
+    std::vector<Uint8> pristineSnapshot;
+
+    // Restart() without recording it; the R key path, whose event is recorded instead
+    void StartOver();
     void SpawnEnemies();
     void CreateBarriers();
     void CheckCollisions();
-    void RenderScore();
+    // Erode the first barrier the projectile overlaps; true if it hit one
+    bool HitBarriers(int projectile);
+    void RenderStaticLayer(const RenderSnapshot& frame);
+    void RenderPerfOverlay(const RenderSnapshot& frame);
 };
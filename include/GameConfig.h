@@ -0,0 +1,64 @@
+#pragma once
+
+// Play field size and the knobs that set how much the simulation has to do.
+// The defaults are the normal game; Stress() scales everything up.
+struct GameConfig {
+    // Logical play field, in pixels. Rendering scales it to the window.
+    float fieldWidth = 800.0f;
+    float fieldHeight = 600.0f;
+
+    // Formation, spawned from the top left of the field
+    int formationColumns = 8;
+    int formationRows = 0;  // 0: 3 rows, plus one for every two levels
+    float formationStartX = 100.0f;
+    float formationStartY = 50.0f;
+    float formationSpacingX = 70.0f;
+    float formationSpacingY = 50.0f;
+
+    // Barriers, in a row above the player
+    int barrierCount = 4;
+    float barrierStartX = 150.0f;
+    float barrierSpacing = 160.0f;
+
+    float enemyFireRate = 1.0f;   // Multiplier on how often each enemy fires
+    int maxPlayerBullets = 1;     // Player bullets allowed in flight at once
+    int projectileCapacity = 1024;
+
+    // Seeds every per-entity random stream; the same seed and input replay
+    // the same game
+    unsigned long long seed = 0x5EED0F1A7ADE5ULL;
+    // Threads used to update large formations: 0 for one per hardware
+    // thread, 1 to run everything on the calling thread
+    int workerThreads = 0;
+
+    // Rows spawned at the given level
+    int FormationRows(int level) const {
+        return formationRows > 0 ? formationRows : 3 + (level - 1) / 2;
+    }
+
+    // Heights measured up from the bottom of the field
+    float PlayerY() const { return fieldHeight - 50.0f; }
+    float BarrierY() const { return fieldHeight - 150.0f; }
+    // The game is lost once an enemy passes this line
+    float InvasionLineY() const { return fieldHeight - 100.0f; }
+
+    // A columns x rows formation in a field just large enough to hold it,
+    // with barriers across the whole width
+    static GameConfig Stress(int columns, int rows) {
+        GameConfig config;
+        config.formationColumns = columns;
+        config.formationRows = rows;
+        config.formationSpacingX = 40.0f;
+        config.formationSpacingY = 40.0f;
+
+        float formationWidth = config.formationStartX * 2.0f + (columns - 1) * config.formationSpacingX;
+        float formationHeight = config.formationStartY + (rows - 1) * config.formationSpacingY;
+        config.fieldWidth = formationWidth > 800.0f ? formationWidth : 800.0f;
+        config.fieldHeight = formationHeight + 400.0f > 600.0f ? formationHeight + 400.0f : 600.0f;
+
+        config.barrierCount = (int)((config.fieldWidth - 2.0f * config.barrierStartX) / config.barrierSpacing) + 1;
+        config.maxPlayerBullets = 16;
+        config.projectileCapacity = 16384;
+        return config;
+    }
+};
@@ -1,7 +1,9 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <string>
+#include <cstddef>
 #include <unordered_map>
+#include <vector>
 
 struct Color {
     Uint8 r, g, b, a;
@@ -10,6 +12,28 @@ struct Color {
         : r(r), g(g), b(b), a(a) {}
 };
 
+// Counts for the last presented frame
+struct RenderStats {
+    int drawCalls = 0;    // SDL draw calls issued (clear, geometry batches, textures)
+    int stateChanges = 0; // Draw calls that used a different texture from the one before
+    int primitives = 0;   // Rects and lines queued
+};
+
+// Textures are referred to by handle; 0 is never a valid handle
+using TextureHandle = Uint32;
+constexpr TextureHandle InvalidTexture = 0;
+
+// Texture cache counters since the Graphics was created
+struct TextureCacheStats {
+    int textures = 0;           // Handles currently allocated
+    int resident = 0;           // Of those, textures currently in memory
+    size_t residentBytes = 0;   // Estimated memory used by resident textures
+    long long loads = 0;        // Textures loaded or created
+    long long evictions = 0;    // Textures dropped to stay under the budget
+};
+
+// The render context shared by everything that draws. There is one per
+// window; entities are handed it when they render rather than keeping their own.
 class Graphics {
 public:
     Graphics(SDL_Renderer* renderer);
@@ -18,21 +42,80 @@ public:
     // Basic drawing functions
     void Clear(const Color& color = Color(0, 0, 0, 255));
     void Present();
+    // Draw into target, a texture created with SDL_TEXTUREACCESS_TARGET, until
+    // the next call; null draws to the window again
+    void SetRenderTarget(SDL_Texture* target);
     
-    // Primitive drawing functions
+    // Primitive drawing functions. These are queued as colored triangles and
+    // drawn in submission order with one SDL_RenderGeometry call per Flush.
     void DrawRect(const SDL_FRect& rect, const Color& color, bool filled = true);
     void DrawLine(float x1, float y1, float x2, float y2, const Color& color);
     
-    // Texture management
-    SDL_Texture* LoadTexture(const std::string& path);
+    // Draw everything queued so far. Called automatically before any texture
+    // draw and at Present, so callers only need it before drawing with SDL directly.
+    void Flush();
+    
+    const RenderStats& GetLastFrameStats() const { return lastFrameStats; }
+    
+    // Texture management. Textures loaded from a file may be evicted when
+    // the cache is over budget and are reloaded on their next use; textures
+    // created with CreateTexture are never evicted.
+    static constexpr size_t defaultTextureBudget = 64 * 1024 * 1024;
+    
+    // Loading the same path twice returns the same handle
+    TextureHandle LoadTexture(const std::string& path);
+    TextureHandle CreateTexture(int width, int height, SDL_TextureAccess access,
+                                SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA8888);
+    void ReleaseTexture(TextureHandle handle);
+    // Null if the handle is invalid or the texture could not be (re)loaded
+    SDL_Texture* GetTexture(TextureHandle handle);
+    void SetTextureBudget(size_t bytes);
+    const TextureCacheStats& GetTextureStats() const { return textureStats; }
+    
     void DrawTexture(SDL_Texture* texture, const SDL_FRect& destRect, 
                      const SDL_FRect* srcRect = nullptr, float angle = 0.0f, 
                      const SDL_FPoint* center = nullptr, SDL_FlipMode flip = SDL_FLIP_NONE);
+    void DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount,
+                      const int* indices, int indexCount);
     
     // Getters
     SDL_Renderer* GetRenderer() const { return renderer; }
 
 private:
+    struct TextureEntry {
+        SDL_Texture* texture = nullptr;  // Null while evicted or released
+        std::string path;                // Empty for created textures
+        size_t bytes = 0;
+        Uint64 lastUsedFrame = 0;
+        bool inUse = false;
+    };
+    
     SDL_Renderer* renderer;
-    std::unordered_map<std::string, SDL_Texture*> textureCache;
+    
+    // Indexed by handle - 1; released slots are reused
+    std::vector<TextureEntry> textures;
+    std::vector<TextureHandle> freeHandles;
+    // Only consulted by LoadTexture, never when drawing
+    std::unordered_map<std::string, TextureHandle> handlesByPath;
+    size_t textureBudget = defaultTextureBudget;
+    TextureCacheStats textureStats;
+    Uint64 frame = 0;
+    
+    // Queued primitives
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    
+    RenderStats frameStats;
+    RenderStats lastFrameStats;
+    SDL_Texture* boundTexture = nullptr;  // Texture of the last draw call this frame
+    
+    void QueueQuad(const SDL_FPoint corners[4], const Color& color);
+    void CountDrawCall(SDL_Texture* texture);
+    
+    TextureHandle AllocateHandle();
+    TextureEntry* FindEntry(TextureHandle handle);
+    bool LoadEntry(TextureEntry& entry);
+    void DestroyEntryTexture(TextureEntry& entry);
+    // Evict least recently used file textures until under budget
+    void TrimTextures();
 };
@@ -0,0 +1,62 @@
+#pragma once
+#include <string_view>
+#include "Graphics.h"
+#include "TextRenderer.h"
+
+struct RenderSnapshot;
+
+// One line of HUD text with up to maxValues bound integers. The text is
+// formatted into a fixed buffer only when a value changes, and its laid-out
+// quads are redrawn as they are until then, so an unchanged label costs one
+// geometry call and no allocations.
+class HudLabel {
+public:
+    static constexpr int capacity = 96;
+    static constexpr int maxValues = 4;
+
+    // format is the text, with {} where each bound value goes in order; it
+    // must outlive the label. Drawn centered on x, y.
+    HudLabel(const char* format, float x, float y, const Color& color);
+
+    void Set(int index, int value) {
+        if (values[index] != value) {
+            values[index] = value;
+            formatted = false;
+        }
+    }
+    void Draw(TextRenderer& text);
+
+    std::string_view GetText() const { return std::string_view(buffer, length); }
+
+private:
+    const char* format;
+    float x;
+    float y;
+    Color color;
+    int values[maxValues] = {};
+
+    char buffer[capacity];
+    int length = 0;
+    bool formatted = false;  // buffer matches values
+    TextLayout layout;
+    bool laidOut = false;    // layout matches buffer
+
+    void Format();
+};
+
+// The score line and the game-over text
+class Hud {
+public:
+    Hud(TextRenderer* text, float fieldWidth, float fieldHeight);
+
+    void RenderScore(const RenderSnapshot& frame);
+    // Text only; the caller darkens the board under it
+    void RenderGameOver(const RenderSnapshot& frame);
+
+private:
+    TextRenderer* text;
+    HudLabel scoreLine;
+    HudLabel gameOver;
+    HudLabel restartHint;
+    HudLabel finalScore;
+};
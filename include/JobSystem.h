@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A small work-stealing thread pool. Each thread owns a queue of jobs; it
+// takes its own work from the back and, when that runs out, steals from the
+// front of the others. The thread calling ParallelFor works too, so a pool
+// of N threads starts N - 1 workers.
+class JobSystem {
+public:
+    // 0 uses every hardware thread; 1 runs everything on the caller
+    explicit JobSystem(int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int ThreadCount() const { return (int)queues.size(); }
+
+    // Calls body(begin, end) over disjoint ranges covering [0, count) and
+    // returns when all of them are done. Ranges hold at least grain items
+    // except the last; a count of grain or less runs inline. body must only
+    // touch state belonging to its range, and the result must not depend on
+    // how the range is split. Only one thread may call ParallelFor at a time.
+    template <typename Body>
+    void ParallelFor(int count, int grain, Body&& body);
+
+private:
+    // One ParallelFor call
+    struct Batch {
+        void (*run)(void* body, int begin, int end);
+        void* body;
+        std::atomic<int> remaining{0};
+    };
+
+    struct Job {
+        Batch* batch;
+        int begin;
+        int end;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // Index 0 belongs to the caller
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    unsigned long long submitted = 0;  // Bumped under wakeMutex whenever jobs are queued
+    bool stopping = false;
+
+    void Run(Batch& batch, int count, int grain);
+    void WorkerLoop(int index);
+    // Runs one job from queue index's own end or stolen from another; false if every queue is empty
+    bool RunOne(int index);
+    bool Pop(int index, Job& job);
+    bool Steal(int thief, Job& job);
+};
+
+template <typename Body>
+void JobSystem::ParallelFor(int count, int grain, Body&& body) {
+    if (count <= 0) {
+        return;
+    }
+    if (count <= grain || queues.size() == 1) {
+        body(0, count);
+        return;
+    }
+
+    Batch batch;
+    batch.body = &body;
+    batch.run = [](void* b, int begin, int end) {
+        (*static_cast<std::remove_reference_t<Body>*>(b))(begin, end);
+    };
+    Run(batch, count, grain);
+}
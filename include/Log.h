@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Count
+};
+
+enum class LogCategory : uint8_t {
+    General,
+    Game,
+    Render,
+    Assets,
+    Replay,
+    Files,
+    Count
+};
+
+const char* GetLogLevelName(LogLevel level);
+const char* GetLogCategoryName(LogCategory category);
+
+// Asynchronous logging. A call formats the message into the calling
+// thread's own lock-free ring buffer and returns; a background thread
+// writes the rings out. Calls never block or allocate after a thread's
+// first, and messages longer than maxLogMessageLength are cut. When a
+// ring is full the message is dropped and counted.
+//
+// Before StartLogging and after StopLogging, messages go straight to stderr.
+constexpr int maxLogMessageLength = 231;
+
+// Start the writer thread, appending to path, or to stderr if path is null
+// or empty. False if the file cannot be opened.
+bool StartLogging(const char* path = nullptr);
+// Write out everything logged so far and stop the writer thread
+void StopLogging();
+
+// Messages below level are discarded at the call; Info by default
+void SetLogLevel(LogLevel level);
+// Messages lost to full ring buffers since the program started
+uint64_t GetDroppedLogCount();
+
+#if defined(__GNUC__) || defined(__clang__)
+#define INVADERS_PRINTF_FORMAT(formatIndex, firstArg) __attribute__((format(printf, formatIndex, firstArg)))
+#else
+#define INVADERS_PRINTF_FORMAT(formatIndex, firstArg)
+#endif
+
+// printf-style; use the LOG_ macros rather than calling this directly
+void LogWrite(LogLevel level, LogCategory category, const char* format, ...) INVADERS_PRINTF_FORMAT(3, 4);
+
+#define LOG_ERROR(category, ...) LogWrite(LogLevel::Error, LogCategory::category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) LogWrite(LogLevel::Warning, LogCategory::category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LogWrite(LogLevel::Info, LogCategory::category, __VA_ARGS__)
+
+// Compiled out of release builds, arguments included
+#ifdef NDEBUG
+#define LOG_DEBUG(category, ...) ((void)0)
+#else
+#define LOG_DEBUG(category, ...) LogWrite(LogLevel::Debug, LogCategory::category, __VA_ARGS__)
+#endif
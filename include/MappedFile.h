@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped into memory. Open maps an existing file read-only;
+// Create makes (or truncates) a file of a fixed size and maps it writable.
+// The mapping is released by Close or the destructor.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    bool Create(const std::string& path, size_t size);
+    void Close();
+
+    uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    bool Map(bool writable);
+};
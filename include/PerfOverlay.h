@@ -0,0 +1,33 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "FrameProfiler.h"
+
+class Graphics;
+class TextRenderer;
+
+// Live counts shown under the timings
+struct PerfCounts {
+    int enemies = 0;
+    int bullets = 0;
+    int bricks = 0;         // Intact barrier cells
+    int drawCalls = 0;      // In the last presented frame
+    int textures = 0;       // Texture cache handles
+};
+
+// Frame time, FPS and a stacked graph of the last FrameProfiler::historySize
+// frames, one column per frame with one colour per phase. Drawn in its own
+// small font so it fits alongside the game.
+class PerfOverlay {
+public:
+    PerfOverlay(Graphics* graphics, const std::string& fontPath);
+    ~PerfOverlay();
+
+    void Render(const FrameProfiler& profiler, const PerfCounts& counts);
+
+private:
+    Graphics* graphics;
+    std::unique_ptr<TextRenderer> text;
+
+    void DrawLine(const std::string& line, float x, float y);
+};
@@ -1,20 +1,30 @@
 #pragma once
 #include <SDL3/SDL.h>
-#include <vector>
-#include <memory>
-#include "Graphics.h"
-
-class Bullet;
+#include "ProjectilePool.h"
+#include "GameConfig.h"
 
 class Player {
 public:
-    Player(Graphics* graphics);
+    static constexpr float width = 40.0f;
+    static constexpr float height = 30.0f;
+
+    // Everything that changes during play, for snapshots
+    struct State {
+        SDL_FPoint position;
+        SDL_FPoint previousPosition;
+        SDL_FPoint velocity;
+        float shootCooldown;
+        int lives;
+        bool moveLeft;
+        bool moveRight;
+        bool isShooting;
+    };
+
+    Player(ProjectilePool* projectiles, const GameConfig* config);
     ~Player();
 
     void HandleEvent(const SDL_Event& event);
     void Update(float deltaTime);
-    void Render();
-    void Reset();
     
     void SetPosition(float x, float y);
     SDL_FPoint GetPosition() const { return position; }
@@ -24,15 +34,16 @@ public:
     void Destroy() { lives = 0; }
     void TakeDamage();
     
-    const std::vector<std::unique_ptr<Bullet>>& GetBullets() const { return bullets; }
+    State GetState() const;
+    void SetState(const State& state);
 
 private:
-    Graphics* graphics;
+    ProjectilePool* projectiles;
+    const GameConfig* config;
     SDL_FPoint position{0.0f, 0.0f};
+    SDL_FPoint previousPosition{0.0f, 0.0f};  // Position at the start of the last tick
     SDL_FPoint velocity{0.0f, 0.0f};
     
-    float width = 40.0f;
-    float height = 30.0f;
     float moveSpeed = 300.0f;
     float shootCooldown = 0.0f;
     int lives = 3;
@@ -42,8 +53,5 @@ private:
     bool moveRight = false;
     bool isShooting = false;
     
-    std::vector<std::unique_ptr<Bullet>> bullets;
-    
     void Shoot();
-    void UpdateBullets(float deltaTime);
 };
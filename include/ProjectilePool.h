@@ -0,0 +1,83 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include "Archetype.h"
+#include "Components.h"
+
+class BinaryWriter;
+class BinaryReader;
+
+enum class ProjectileOwner : uint8_t {
+    Player,
+    Enemy
+};
+
+// Every bullet in play, stored as one archetype. Capacity is allocated up
+// front; spawning appends and removal swaps the last projectile into the hole,
+// so indices are only stable until the next Integrate().
+class ProjectilePool {
+public:
+    ProjectilePool(int capacity, float fieldWidth, float fieldHeight);
+    ~ProjectilePool();
+
+    // Returns the new index, or -1 if the pool is full
+    int Spawn(float x, float y, float vx, float vy, ProjectileOwner owner);
+
+    // Mark a projectile dead; it is removed by the next Integrate()
+    void Kill(int index) { store.Get<Alive>(index).value = 0; }
+    void Clear();
+
+    // Move every projectile and swap-remove the dead and the out-of-bounds
+    void Integrate(float deltaTime);
+    // The two halves of Integrate. Move only touches [begin, end), so
+    // separate ranges can be moved in parallel; RemoveSpent must run alone
+    // once every range has moved.
+    void Move(int begin, int end, float deltaTime);
+    void RemoveSpent();
+
+    // Every live projectile, for snapshots. Load fails if the saved pool
+    // does not fit this one's capacity.
+    void Save(BinaryWriter& writer) const;
+    bool Load(BinaryReader& reader);
+
+    int Count() const { return store.Count(); }
+    int Capacity() const { return capacity; }
+    int CountOwned(ProjectileOwner who) const { return ownedCount[(int)who]; }
+
+    bool IsAlive(int index) const { return store.Get<Alive>(index).value != 0; }
+    ProjectileOwner GetOwner(int index) const { return store.Get<ProjectileOwner>(index); }
+    SDL_FPoint GetPosition(int index) const {
+        const Position& position = store.Get<Position>(index);
+        return SDL_FPoint{position.x, position.y};
+    }
+    // Where the projectile was at the start of the last Integrate
+    SDL_FPoint GetPreviousPosition(int index) const {
+        const PreviousPosition& previous = store.Get<PreviousPosition>(index);
+        return SDL_FPoint{previous.x, previous.y};
+    }
+    SDL_FPoint GetVelocity(int index) const {
+        const Velocity& velocity = store.Get<Velocity>(index);
+        return SDL_FPoint{velocity.x, velocity.y};
+    }
+    SDL_FRect GetBounds(int index) const {
+        const Position& position = store.Get<Position>(index);
+        return SDL_FRect{
+            position.x - width * 0.5f,
+            position.y - height * 0.5f,
+            width,
+            height
+        };
+    }
+
+    // Every projectile has the same size
+    static constexpr float width = 5.0f;
+    static constexpr float height = 15.0f;
+
+private:
+    int capacity;
+    int ownedCount[2] = {0, 0};
+    float fieldWidth;
+    float fieldHeight;
+
+    Archetype<Position, PreviousPosition, Velocity, ProjectileOwner, Alive> store;
+};
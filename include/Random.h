@@ -0,0 +1,20 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+// Counter-based random numbers (Philox4x32-10). Each draw is a pure function
+// of (seed, stream, counter) with no generator state, so entities can draw
+// on any thread in any order and a run replays exactly from its seed. The
+// simulation uses an entity id as the stream and the tick as the counter.
+
+// 32 random bits
+Uint32 RandomBits(Uint64 seed, Uint64 stream, Uint64 counter);
+
+// Uniform in [0, 1), with 24 bits of precision
+float RandomFloat(Uint64 seed, Uint64 stream, Uint64 counter);
+
+// Uniform in [min, max)
+float RandomRange(Uint64 seed, Uint64 stream, Uint64 counter, float min, float max);
+
+// out[i] = RandomFloat(seed, streams[i], counter) for i in [0, count), several
+// streams at a time with SIMD. Bit-identical to the scalar version.
+void FillRandomFloats(Uint64 seed, const Uint64* streams, Uint64 counter, float* out, int count);
@@ -0,0 +1,43 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "Barrier.h"
+#include "FrameProfiler.h"
+
+// Where a moving thing was at the start of the last tick and where it is now
+struct SpriteFrame {
+    SDL_FPoint previous;
+    SDL_FPoint current;
+};
+
+// Everything a frame draws, copied out of the game after a tick. It points
+// into nothing the simulation owns, so one thread can draw it while another
+// runs the next tick. Sizes and colors are fixed per kind of entity and are
+// not copied.
+struct RenderSnapshot {
+    Uint64 sequence = 0;   // Bumped by every capture
+    Uint64 tick = 0;       // Game tick the snapshot was taken after
+    Uint64 tickDueNS = 0;  // Wall time that tick was due, for interpolation; 0 if unpaced
+
+    bool playerVisible = false;
+    SpriteFrame player{};
+    bool ufoVisible = false;
+    SpriteFrame ufo{};
+    // Living enemies are drawn at their cell center plus the formation offset
+    SpriteFrame formationOffset{};
+    std::vector<SDL_FPoint> enemies;
+    std::vector<SpriteFrame> projectiles;  // Living projectiles only
+    std::vector<Barrier::State> barriers;
+    int bricks = 0;                        // Intact barrier cells
+
+    int score = 0;
+    int highScore = 0;
+    int level = 1;
+    int lives = 0;
+    bool gameOver = false;
+    bool showPerfOverlay = false;
+
+    // Update and Collisions time since the previous capture, added to the
+    // frame profiler when the snapshot is first drawn
+    FrameTiming simulation;
+};
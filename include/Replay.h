@@ -0,0 +1,103 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameConfig.h"
+
+class Game;
+
+// A replay is the config a game started with (and so its seed) plus every
+// key event Game::HandleEvent saw, tagged with the tick it arrived before.
+// Keyframes hold a full snapshot every few seconds so playback can seek.
+//
+// After the header the file is a list of records, each starting with the
+// varint tick delta from the previous record and a ReplayRecord byte.
+enum class ReplayRecord : uint8_t {
+    Event,     // Flags byte (ReplayKeyDown, ReplayKeyRepeat), varint scancode
+    Restart,   // Game::Restart() called from outside the game
+    Keyframe,  // Varint size, then a Game snapshot taken at the start of the tick
+    End        // Last record; its tick is where playback stops
+};
+
+struct ReplayHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t tickRate;
+    uint32_t keyframeInterval;  // Ticks between keyframes
+    uint32_t configSize;        // sizeof(GameConfig) of the writer
+    GameConfig config;
+};
+
+class ReplayRecorder {
+public:
+    ReplayRecorder(const GameConfig& config, int tickRate, int keyframeInterval);
+
+    // Called by Game; events other than key presses and releases are ignored
+    void RecordEvent(Uint64 tick, const SDL_Event& event);
+    void RecordRestart(Uint64 tick);
+    // Called by Game at the start of every tick; adds a keyframe when one is due
+    void BeginTick(const Game& game);
+
+    // Writes the recording, ending at endTick
+    bool Save(const std::string& path, Uint64 endTick);
+    size_t Size() const { return data.size(); }
+
+private:
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> snapshot;
+    Uint64 lastTick = 0;
+    int keyframeInterval;
+
+    void BeginRecord(Uint64 tick, ReplayRecord kind);
+};
+
+class ReplayPlayer {
+public:
+    bool Load(const std::string& path);
+
+    // Game config with the recorded seed and layout
+    const GameConfig& GetConfig() const { return header.config; }
+    int GetTickRate() const { return (int)header.tickRate; }
+    Uint64 GetEndTick() const { return endTick; }
+
+    // Apply every record due before the game's next tick. Keyframes are
+    // compared with the game as it is; the first mismatch is remembered.
+    void Feed(Game& game);
+    bool IsFinished(const Game& game) const;
+
+    // Restore the last keyframe at or before tick, then simulate up to tick
+    // at full speed. The game must be freshly initialized from GetConfig().
+    bool Seek(Game& game, Uint64 tick);
+
+    bool HasDesynced() const { return desynced; }
+    Uint64 GetDesyncTick() const { return desyncTick; }
+
+private:
+    ReplayHeader header{};
+    std::vector<uint8_t> data;
+    size_t offset = 0;      // Next record
+    Uint64 cursorTick = 0;  // Tick of the last record read
+    Uint64 endTick = 0;
+    bool desynced = false;
+    Uint64 desyncTick = 0;
+    std::vector<uint8_t> snapshot;
+
+    struct Record {
+        ReplayRecord kind;
+        Uint64 tick;
+        uint8_t flags;              // Event
+        uint64_t scancode;          // Event
+        const uint8_t* snapshot;    // Keyframe
+        size_t snapshotSize;        // Keyframe
+        size_t next;                // Offset of the following record
+    };
+
+    // Parses the record at offset whose predecessor was at previousTick;
+    // false past the end or if the record is malformed
+    bool ParseRecord(size_t at, Uint64 previousTick, Record& record) const;
+};
+
+// Bits of the Event record's flags byte
+constexpr uint8_t ReplayKeyDown = 1;
+constexpr uint8_t ReplayKeyRepeat = 2;
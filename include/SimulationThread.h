@@ -0,0 +1,71 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+
+class Game;
+
+// Runs a game's fixed-step loop on its own thread and publishes a
+// RenderSnapshot after every batch of ticks, so the thread that draws and
+// presents (and may block on vsync) never holds up the simulation. Events
+// reach the game through PostEvent and are handled between ticks. While the
+// thread runs, nothing else may touch the game except Draw.
+class SimulationThread {
+public:
+    // Runs before and after each tick on the simulation thread; returning
+    // false stops the simulation
+    using TickHook = std::function<bool(Game&)>;
+
+    // Catches up at most maxCatchUpSteps ticks at a time; an older backlog is
+    // dropped
+    SimulationThread(Game& game, int tickRate, int maxCatchUpSteps);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Set before Start
+    void SetBeforeTick(TickHook hook) { beforeTick = std::move(hook); }
+    void SetAfterTick(TickHook hook) { afterTick = std::move(hook); }
+
+    // Publishes the current state, then starts ticking
+    void Start();
+    // Waits for the tick in progress; the game is the caller's again after
+    void Stop();
+    // A hook stopped the simulation
+    bool IsFinished() const { return finished.load(std::memory_order_acquire); }
+
+    void PostEvent(const SDL_Event& event);
+
+    // Reader side: the newest published snapshot, valid until the next call
+    const RenderSnapshot& AcquireFrame();
+    // How far now is into the tick after frame's (0..1)
+    float GetAlpha(const RenderSnapshot& frame, Uint64 now) const;
+
+private:
+    Game& game;
+    const float tickSeconds;
+    const Uint64 tickNS;
+    const int maxCatchUpSteps;
+    TickHook beforeTick;
+    TickHook afterTick;
+
+    TripleBuffer<RenderSnapshot> frames;
+
+    std::mutex eventMutex;
+    std::vector<SDL_Event> pendingEvents;  // Guarded by eventMutex
+    std::vector<SDL_Event> handledEvents;  // Simulation thread only
+
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> finished{false};
+
+    void Run();
+    // Capture into the back slot and hand it to the reader
+    void Publish(Uint64 tickDueNS);
+};
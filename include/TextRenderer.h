@@ -1,7 +1,9 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include "Graphics.h"
 
 // Include SDL_ttf if available
@@ -9,37 +11,99 @@
 #include <SDL3/SDL_ttf.h>
 #endif
 
+// Glyph atlas counters since the renderer was created
+struct TextCacheStats {
+    long long hits = 0;        // Glyph lookups served from the atlas
+    long long misses = 0;      // Glyphs rasterized into the atlas
+    long long evictions = 0;   // Times the full atlas was emptied
+    int glyphs = 0;            // Glyphs currently in the atlas
+    int atlasBytes = 0;        // Size of the atlas texture
+};
+
+// Glyph quads for one string, laid out against the atlas as it was at the
+// time. Redraw it with DrawLayout until IsCurrent says the atlas has been
+// emptied since. The vectors keep their capacity between layouts.
+struct TextLayout {
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    long long atlasGeneration = -1;
+};
+
+// Draws text from a single glyph atlas. Each glyph is rasterized once, in
+// white, and strings are laid out as tinted quads in one geometry call. The
+// atlas never grows past the memory budget; when it fills up it is emptied
+// and refilled on demand.
 class TextRenderer {
 public:
-    TextRenderer(Graphics* graphics, SDL_Renderer* renderer);
+    // Default atlas budget: one 256x256 RGBA texture
+    static constexpr int defaultAtlasBudget = 256 * 1024;
+
+    TextRenderer(Graphics* graphics, int atlasBudgetBytes = defaultAtlasBudget);
     ~TextRenderer();
-    
+
     // Load font from path
     bool LoadFont(const std::string& path, int fontSize);
-    
+
     // Draw text with specified alignment
-    void DrawText(const std::string& text, float x, float y, const Color& color, bool centered = true);
-    
+    void DrawText(std::string_view text, float x, float y, const Color& color, bool centered = true);
+
+    // Lay text out into layout as DrawText would draw it, for text that is
+    // redrawn unchanged. False when there is no font, as the fallback
+    // renderer has nothing to keep; use DrawText then.
+    bool Layout(std::string_view text, float x, float y, const Color& color, bool centered, TextLayout& layout);
+    bool IsCurrent(const TextLayout& layout) const { return layout.atlasGeneration == atlasGeneration; }
+    void DrawLayout(const TextLayout& layout);
+
     // Get dimensions of text
-    SDL_FPoint GetTextSize(const std::string& text);
+    SDL_FPoint GetTextSize(std::string_view text);
+
+    const TextCacheStats& GetStats() const { return stats; }
 
 private:
     Graphics* graphics;
-    SDL_Renderer* renderer;
-    
+    int atlasBudget;
+    TextCacheStats stats;
+    long long atlasGeneration = 0;  // Bumped whenever the atlas is emptied
+
 #ifndef NO_SDL_TTF
+    struct Glyph {
+        SDL_Rect atlasRect;  // Empty for glyphs with no pixels, such as space
+        int advance;
+    };
+
     TTF_Font* font = nullptr;
-    std::unordered_map<std::string, SDL_Texture*> textCache;
+    int lineHeight = 0;
+
+    // Atlas texture, packed in shelves from the top left. Created through
+    // graphics, which never evicts it, so the pointer stays valid.
+    TextureHandle atlasHandle = InvalidTexture;
+    SDL_Texture* atlas = nullptr;
+    int atlasSize = 0;
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    std::unordered_map<Uint32, Glyph> glyphs;
+
+    // Reused for every string drawn with DrawText
+    TextLayout scratch;
+
+    bool CreateAtlas();
+    void ResetAtlas();
+    // Null if the glyph could not be rasterized
+    const Glyph* GetGlyph(Uint32 codepoint);
+    const Glyph* RasterizeGlyph(Uint32 codepoint);
+    // Fill layout's quads; needs a font and an atlas
+    void LayoutGlyphs(std::string_view text, float x, float y, const Color& color, bool centered, TextLayout& layout);
 #endif
-    
+
     // Fallback method when SDL_ttf is not available
-    void DrawTextFallback(const std::string& text, float x, float y, const Color& color, bool centered);
-    
+    void DrawTextFallback(std::string_view text, float x, float y, const Color& color, bool centered);
+
     // Text dimensions for fallback rendering
     const float charWidth = 12.0f;
     const float charHeight = 20.0f;
     const float charSpacing = 2.0f;
-    
+
     // Draw a single character with primitive shapes (fallback method)
     void DrawCharFallback(char c, float x, float y, const Color& color);
 };
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+// Hands the newest of a stream of values from one writer thread to one
+// reader thread without either ever waiting. The writer fills its back slot
+// and publishes it by swapping it with the shared middle slot; the reader
+// swaps the middle slot for its front slot whenever something new has been
+// published. Values the reader never got to are overwritten. Slots are
+// reused, so values holding vectors keep their capacity.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer: the slot to fill next. Holds whatever was in it three
+    // publishes ago, not the last published value.
+    T& Back() { return slots[back]; }
+    void Publish() {
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader: take the newest published value if there is one; false leaves
+    // Front() as it was
+    bool Acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & freshBit)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+    const T& Front() const { return slots[front]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4;  // Set in middle from Publish until the next Acquire
+
+    T slots[3];
+    int back = 0;                 // Writer only
+    int front = 1;                // Reader only
+    std::atomic<int> middle{2};   // Index of the shared slot, plus freshBit
+};
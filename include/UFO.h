@@ -1,14 +1,29 @@
 #pragma once
 #include <SDL3/SDL.h>
-#include "Graphics.h"
+#include "GameConfig.h"
 
 class UFO {
 public:
-    UFO(Graphics* graphics);
+    static constexpr float width = 50.0f;
+    static constexpr float height = 25.0f;
+
+    // Everything that changes during play, for snapshots
+    struct State {
+        Uint64 id;
+        Uint64 spawns;
+        SDL_FPoint position;
+        SDL_FPoint previousPosition;
+        SDL_FPoint velocity;
+        float spawnTimer;
+        bool destroyed;
+        bool active;
+    };
+
+    // id is the UFO's random stream and must be unique within a game
+    UFO(const GameConfig* config, Uint64 id);
     ~UFO();
 
     void Update(float deltaTime);
-    void Render();
     
     void SetPosition(float x, float y);
     SDL_FPoint GetPosition() const { return position; }
@@ -20,18 +35,24 @@ public:
     int GetScoreValue() const { return scoreValue; }
     bool IsActive() const { return active; }
     
+    State GetState() const;
+    void SetState(const State& state);
+    
 private:
-    Graphics* graphics;
+    const GameConfig* config;
+    Uint64 id;
+    Uint64 spawns = 0;  // Counter for the spawn timer draws
     SDL_FPoint position{0.0f, 0.0f};
+    SDL_FPoint previousPosition{0.0f, 0.0f};  // Position at the start of the last tick
     SDL_FPoint velocity{0.0f, 0.0f};
     
-    float width = 50.0f;
-    float height = 25.0f;
-    
     bool destroyed = false;
     bool active = false;
     float spawnTimer = 0.0f;
     float spawnInterval = 15.0f;  // Spawn every 15 seconds
     
     int scoreValue = 100;  // Points for hitting the UFO
+    
+    // Seconds until the next pass, drawn from the UFO's stream
+    float NextSpawnTime(float minimum);
 };
@@ -0,0 +1,155 @@
+#include "AabbBatch.h"
+#include "CpuFeatures.h"
+#include <limits>
+
+// Padding boxes are inverted so every comparison against them fails
+static const float EMPTY_MIN = std::numeric_limits<float>::infinity();
+static const float EMPTY_MAX = -std::numeric_limits<float>::infinity();
+
+void AabbBatch::Clear() {
+    count = 0;
+    minX.clear();
+    minY.clear();
+    maxX.clear();
+    maxY.clear();
+}
+
+int AabbBatch::Append() {
+    // Grow by a whole block of padding whenever the last block is full
+    if (count == (int)minX.size()) {
+        minX.resize(count + blockSize, EMPTY_MIN);
+        minY.resize(count + blockSize, EMPTY_MIN);
+        maxX.resize(count + blockSize, EMPTY_MAX);
+        maxY.resize(count + blockSize, EMPTY_MAX);
+    }
+    return count++;
+}
+
+int AabbBatch::Add(const SDL_FRect& rect) {
+    int at = Append();
+
+    // Empty rects never intersect anything, so store them as padding
+    if (rect.w >= 0.0f && rect.h >= 0.0f) {
+        minX[at] = rect.x;
+        minY[at] = rect.y;
+        maxX[at] = rect.x + rect.w;
+        maxY[at] = rect.y + rect.h;
+    } else {
+        minX[at] = minY[at] = EMPTY_MIN;
+        maxX[at] = maxY[at] = EMPTY_MAX;
+    }
+    return at;
+}
+
+int AabbBatch::Add(const AabbBatch& other, int index) {
+    int at = Append();
+    minX[at] = other.minX[index];
+    minY[at] = other.minY[index];
+    maxX[at] = other.maxX[index];
+    maxY[at] = other.maxY[index];
+    return at;
+}
+
+static uint32_t OverlapMaskScalar(const SDL_FRect& box, const AabbBatch& batch, int first) {
+    const float bx0 = box.x;
+    const float by0 = box.y;
+    const float bx1 = box.x + box.w;
+    const float by1 = box.y + box.h;
+
+    const float* minX = batch.MinX() + first;
+    const float* minY = batch.MinY() + first;
+    const float* maxX = batch.MaxX() + first;
+    const float* maxY = batch.MaxY() + first;
+
+    uint32_t mask = 0;
+    for (int i = 0; i < AabbBatch::blockSize; i++) {
+        // Non-short-circuit so the compiler can keep this branch-free
+        bool hit = (bx0 <= maxX[i]) & (minX[i] <= bx1) & (by0 <= maxY[i]) & (minY[i] <= by1);
+        mask |= (uint32_t)hit << i;
+    }
+    return mask;
+}
+
+#ifdef INVADERS_HAVE_X86
+static uint32_t OverlapMaskSSE2(const SDL_FRect& box, const AabbBatch& batch, int first) {
+    const __m128 bx0 = _mm_set1_ps(box.x);
+    const __m128 by0 = _mm_set1_ps(box.y);
+    const __m128 bx1 = _mm_set1_ps(box.x + box.w);
+    const __m128 by1 = _mm_set1_ps(box.y + box.h);
+
+    uint32_t mask = 0;
+    for (int i = 0; i < AabbBatch::blockSize; i += 4) {
+        int at = first + i;
+        __m128 hit = _mm_and_ps(
+            _mm_and_ps(_mm_cmple_ps(bx0, _mm_loadu_ps(batch.MaxX() + at)),
+                       _mm_cmple_ps(_mm_loadu_ps(batch.MinX() + at), bx1)),
+            _mm_and_ps(_mm_cmple_ps(by0, _mm_loadu_ps(batch.MaxY() + at)),
+                       _mm_cmple_ps(_mm_loadu_ps(batch.MinY() + at), by1)));
+        mask |= (uint32_t)_mm_movemask_ps(hit) << i;
+    }
+    return mask;
+}
+
+INVADERS_TARGET_AVX2
+static uint32_t OverlapMaskAVX2(const SDL_FRect& box, const AabbBatch& batch, int first) {
+    const __m256 bx0 = _mm256_set1_ps(box.x);
+    const __m256 by0 = _mm256_set1_ps(box.y);
+    const __m256 bx1 = _mm256_set1_ps(box.x + box.w);
+    const __m256 by1 = _mm256_set1_ps(box.y + box.h);
+
+    uint32_t mask = 0;
+    for (int i = 0; i < AabbBatch::blockSize; i += 8) {
+        int at = first + i;
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(bx0, _mm256_loadu_ps(batch.MaxX() + at), _CMP_LE_OQ),
+                          _mm256_cmp_ps(_mm256_loadu_ps(batch.MinX() + at), bx1, _CMP_LE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(by0, _mm256_loadu_ps(batch.MaxY() + at), _CMP_LE_OQ),
+                          _mm256_cmp_ps(_mm256_loadu_ps(batch.MinY() + at), by1, _CMP_LE_OQ)));
+        mask |= (uint32_t)_mm256_movemask_ps(hit) << i;
+    }
+    return mask;
+}
+#endif
+
+AabbKernel DetectAabbKernel() {
+#ifdef INVADERS_HAVE_X86
+    static const AabbKernel detected = CpuHasAVX2() ? AabbKernel::AVX2 : AabbKernel::SSE2;
+    return detected;
+#else
+    return AabbKernel::Scalar;
+#endif
+}
+
+AabbOverlapFn GetAabbKernel(AabbKernel kernel) {
+    switch (kernel) {
+        case AabbKernel::Scalar:
+            return OverlapMaskScalar;
+#ifdef INVADERS_HAVE_X86
+        case AabbKernel::SSE2:
+            return OverlapMaskSSE2;
+        case AabbKernel::AVX2:
+            return CpuHasAVX2() ? OverlapMaskAVX2 : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const char* GetAabbKernelName(AabbKernel kernel) {
+    switch (kernel) {
+        case AabbKernel::Scalar: return "scalar";
+        case AabbKernel::SSE2:   return "sse2";
+        case AabbKernel::AVX2:   return "avx2";
+    }
+    return "unknown";
+}
+
+uint32_t OverlapMask16(const SDL_FRect& box, const AabbBatch& batch, int first) {
+    static const AabbOverlapFn kernel = GetAabbKernel(DetectAabbKernel());
+
+    // Empty rects never intersect, matching SDL_HasRectIntersectionFloat
+    if (box.w < 0.0f || box.h < 0.0f) {
+        return 0;
+    }
+    return kernel(box, batch, first);
+}
@@ -1,62 +1,133 @@
-#include "../../Entity/Barrier.h"
+#include "Barrier.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
 
-Barrier::Barrier(Graphics* graphics, float x, float y) : graphics(graphics) {
-    position.x = x;
-    position.y = y;
-    CreateBricks();
+// Crater blasted by each hit, one row of cells per entry (bit 0 is the
+// leftmost column of the stamp)
+static const int CRATER_WIDTH = 6;
+static const int CRATER_HEIGHT = 6;
+static const uint64_t CRATER[CRATER_HEIGHT] = {
+    0b011110,
+    0b111111,
+    0b111111,
+    0b111111,
+    0b111111,
+    0b011110,
+};
+
+static const uint64_t ROW_MASK = (uint64_t(1) << Barrier::cols) - 1;
+
+// Bits first..last inclusive
+static uint64_t ColumnMask(int first, int last) {
+    return (ROW_MASK >> (Barrier::cols - 1 - last)) & ~((uint64_t(1) << first) - 1);
 }
 
-Barrier::~Barrier() {
+Barrier::Barrier(float x, float y) {
+    position.x = x;
+    position.y = y;
+    CreateCells();
 }
 
 void Barrier::Update(float deltaTime) {
     // Barriers are static, so no update logic needed
 }
 
-void Barrier::Render() {
-    Color barrierColor(0, 200, 0);  // Dark green
-    
-    // Render each brick that's not destroyed
-    for (const auto& brick : bricks) {
-        if (!brick.destroyed) {
-            graphics->DrawRect(brick.rect, barrierColor, true);
+void Barrier::CreateCells() {
+    // Create a barrier shape (inverted U) with an opening in the middle of
+    // the bottom sixth, the same footprint as the old 10 px brick layout
+    const int archTop = rows - rows / 6;
+    const uint64_t arch = ColumnMask(3 * cols / 8, 5 * cols / 8 - 1);
+
+    for (int row = 0; row < rows; row++) {
+        cells[row] = row >= archTop ? ROW_MASK & ~arch : ROW_MASK;
+    }
+}
+
+Barrier::State Barrier::GetState() const {
+    State state;
+    state.position = position;
+    std::memcpy(state.cells, cells, sizeof(cells));
+    return state;
+}
+
+void Barrier::SetState(const State& state) {
+    position = state.position;
+    std::memcpy(cells, state.cells, sizeof(cells));
+}
+
+bool Barrier::CellRange(const SDL_FRect& rect, int& col0, int& row0, int& col1, int& row1) const {
+    SDL_FRect bounds = GetBounds();
+    if (!SDL_HasRectIntersectionFloat(&rect, &bounds)) {
+        return false;
+    }
+
+    col0 = std::max(0, (int)std::floor((rect.x - bounds.x) / cellSize));
+    row0 = std::max(0, (int)std::floor((rect.y - bounds.y) / cellSize));
+    col1 = std::min(cols - 1, (int)std::floor((rect.x + rect.w - bounds.x) / cellSize));
+    row1 = std::min(rows - 1, (int)std::floor((rect.y + rect.h - bounds.y) / cellSize));
+    return col0 <= col1 && row0 <= row1;
+}
+
+bool Barrier::Overlaps(const SDL_FRect& rect) const {
+    int col0, row0, col1, row1;
+    if (!CellRange(rect, col0, row0, col1, row1)) {
+        return false;
+    }
+
+    uint64_t columns = ColumnMask(col0, col1);
+    for (int row = row0; row <= row1; row++) {
+        if (cells[row] & columns) {
+            return true;
         }
     }
+    return false;
 }
 
-void Barrier::CreateBricks() {
-    // Create a rectangular barrier made of smaller bricks
-    const int rows = (int)(height / brickSize);
-    const int cols = (int)(width / brickSize);
-    
-    // Create a barrier shape (inverted U)
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < cols; col++) {
-            // Skip bricks to create an opening in the middle of the bottom row
-            if (row == rows - 1 && col > cols/3 && col < 2*cols/3) {
-                continue;
-            }
-            
-            // Calculate brick position
-            float brickX = position.x - width/2 + col * brickSize + brickSize/2;
-            float brickY = position.y - height/2 + row * brickSize + brickSize/2;
-            
-            // Add the brick
-            Brick brick;
-            brick.rect = {
-                brickX - brickSize/2,
-                brickY - brickSize/2,
-                brickSize,
-                brickSize
-            };
-            brick.destroyed = false;
-            bricks.push_back(brick);
+bool Barrier::Hit(const SDL_FRect& rect, float vy) {
+    int col0, row0, col1, row1;
+    if (!CellRange(rect, col0, row0, col1, row1)) {
+        return false;
+    }
+
+    // Walk the rows in the direction of travel so the crater lands on the
+    // face the bullet reached first
+    uint64_t columns = ColumnMask(col0, col1);
+    int step = vy >= 0.0f ? 1 : -1;
+    int first = step > 0 ? row0 : row1;
+    int last = step > 0 ? row1 : row0;
+
+    for (int row = first; row != last + step; row += step) {
+        uint64_t hit = cells[row] & columns;
+        if (hit) {
+            // Centre the crater between the leftmost and rightmost hit cells
+            int left = std::countr_zero(hit);
+            int right = 63 - std::countl_zero(hit);
+            Erode((left + right) / 2, row);
+            return true;
         }
     }
+    return false;
 }
 
-void Barrier::DamageBrick(int index) {
-    if (index >= 0 && index < (int)bricks.size()) {
-        bricks[index].destroyed = true;
+void Barrier::Erode(int col, int row) {
+    int left = col - CRATER_WIDTH / 2;
+    int top = row - CRATER_HEIGHT / 2;
+
+    for (int i = 0; i < CRATER_HEIGHT; i++) {
+        int r = top + i;
+        if (r < 0 || r >= rows) continue;
+
+        uint64_t stamp = left >= 0 ? CRATER[i] << left : CRATER[i] >> -left;
+        cells[r] &= ~stamp & ROW_MASK;
+    }
+}
+
+int Barrier::CountIntactCells() const {
+    int count = 0;
+    for (int row = 0; row < rows; row++) {
+        count += std::popcount(cells[row]);
     }
+    return count;
 }
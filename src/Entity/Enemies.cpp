@@ -0,0 +1,90 @@
+#include "Enemies.h"
+#include "ProjectilePool.h"
+#include "Random.h"
+
+static_assert(sizeof(RandomStream) == sizeof(Uint64), "the stream column is read as plain ids");
+
+Enemies::Enemies(const GameConfig* config) : config(config), formation(config, width, height) {
+}
+
+void Enemies::Form(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing, Uint64 firstStream) {
+    store.Clear();
+    formation.Form(columns, rows, origin, spacing);
+    store.Reserve(formation.GetAliveCount());
+
+    Uint64 stream = firstStream;
+    for (int row = 0; row < formation.GetState().rows; row++) {
+        for (int column = 0; column < formation.GetState().columns; column++) {
+            store.Create(FormationCell{column, row}, Weapon{}, RandomStream{stream++});
+        }
+    }
+    LinkCells();
+}
+
+void Enemies::Clear() {
+    store.Clear();
+    formation.Clear();
+    cellHandles.clear();
+}
+
+void Enemies::RestoreFormation(const Formation::State& state) {
+    formation.SetState(state, store.Data<FormationCell>(), store.Count());
+    LinkCells();
+}
+
+void Enemies::LinkCells() {
+    const int columns = formation.GetState().columns;
+    cellHandles.assign((size_t)columns * formation.GetState().rows, EntityHandle{});
+    const FormationCell* cell = store.Data<FormationCell>();
+    for (int i = 0; i < store.Count(); i++) {
+        if (formation.IsAlive(cell[i].column, cell[i].row)) {
+            cellHandles[cell[i].row * columns + cell[i].column] = store.HandleAt(i);
+        }
+    }
+}
+
+void Enemies::DecideFire(int begin, int end, float deltaTime, Uint64 tick, float* rolls) {
+    const Uint64* streams = reinterpret_cast<const Uint64*>(store.Data<RandomStream>());
+    FillRandomFloats(config->seed, streams + begin, tick, rolls, end - begin);
+
+    const FormationCell* cell = store.Data<FormationCell>();
+    Weapon* weapon = store.Data<Weapon>();
+    const float threshold = shootProbability * config->enemyFireRate;
+    for (int i = begin; i < end; i++) {
+        if (weapon[i].cooldown > 0.0f) {
+            weapon[i].cooldown -= deltaTime;
+        }
+        // Only an enemy with a clear line below it fires. The bullet is
+        // spawned later by Fire so that parallel ranges never share the pool.
+        if (weapon[i].cooldown <= 0.0f && rolls[i - begin] < threshold &&
+            formation.GetFrontRow(cell[i].column) == cell[i].row) {
+            weapon[i].fireRequested = 1;
+        }
+    }
+}
+
+void Enemies::Fire(ProjectilePool& projectiles) {
+    Weapon* weapon = store.Data<Weapon>();
+    for (int i = 0; i < store.Count(); i++) {
+        if (!weapon[i].fireRequested) continue;
+
+        // Shoot downward
+        weapon[i].fireRequested = 0;
+        SDL_FPoint position = GetPosition(i);
+        projectiles.Spawn(position.x, position.y + height * 0.5f, 0.0f, 300.0f, ProjectileOwner::Enemy);
+        weapon[i].cooldown = 5.0f / config->enemyFireRate;
+    }
+}
+
+int Enemies::FindHit(const SDL_FRect& bounds) const {
+    int column;
+    int row;
+    if (!formation.FindHit(bounds, column, row)) {
+        return -1;
+    }
+    return store.RowOf(cellHandles[row * formation.GetState().columns + column]);
+}
+
+void Enemies::RemoveDead() {
+    store.RemoveIf([&](int row) { return !IsAlive(row); });
+}
@@ -0,0 +1,160 @@
+#include "Formation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Formation::Formation(const GameConfig* config, float cellWidth, float cellHeight)
+    : config(config), cellWidth(cellWidth), cellHeight(cellHeight) {
+    Clear();
+}
+
+void Formation::Clear() {
+    // Zeroed first so that padding never differs between equal states
+    std::memset(&state, 0, sizeof(state));
+    state.direction = 1.0f;
+    Allocate();
+    Refit();
+}
+
+void Formation::Form(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing) {
+    Clear();
+    state.origin = origin;
+    state.spacing = spacing;
+    state.columns = std::max(columns, 0);
+    state.rows = std::max(rows, 0);
+    state.alive = state.columns * state.rows;
+    Allocate();
+
+    for (int row = 0; row < state.rows; row++) {
+        for (int word = 0; word < wordsPerRow; word++) {
+            int bits = std::min(state.columns - word * 64, 64);
+            aliveMasks[row * wordsPerRow + word] = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+        }
+    }
+    std::fill(frontRows.begin(), frontRows.end(), state.rows - 1);
+    Refit();
+}
+
+void Formation::Kill(int column, int row) {
+    if (!IsAlive(column, row)) {
+        return;
+    }
+    aliveMasks[row * wordsPerRow + column / 64] &= ~(1ULL << (column % 64));
+    state.alive--;
+
+    // Walk up the column to the next enemy that can be hit from below
+    if (frontRows[column] == row) {
+        int front = row - 1;
+        while (front >= 0 && !IsAlive(column, front)) {
+            front--;
+        }
+        frontRows[column] = front;
+        Refit();
+    }
+}
+
+void Formation::SetState(const State& newState, const FormationCell* cells, int count) {
+    state = newState;
+    state.columns = std::max(state.columns, 0);
+    state.rows = std::max(state.rows, 0);
+    state.alive = 0;
+    Allocate();
+
+    for (int i = 0; i < count; i++) {
+        const FormationCell& cell = cells[i];
+        if (cell.column < 0 || cell.column >= state.columns || cell.row < 0 || cell.row >= state.rows ||
+            IsAlive(cell.column, cell.row)) {
+            continue;
+        }
+        aliveMasks[cell.row * wordsPerRow + cell.column / 64] |= 1ULL << (cell.column % 64);
+        frontRows[cell.column] = std::max(frontRows[cell.column], cell.row);
+        state.alive++;
+    }
+    Refit();
+}
+
+void Formation::Allocate() {
+    wordsPerRow = (state.columns + 63) / 64;
+    aliveMasks.assign((size_t)state.rows * wordsPerRow, 0);
+    frontRows.assign(state.columns, -1);
+}
+
+void Formation::Refit() {
+    state.firstColumn = -1;
+    state.lastColumn = -1;
+    state.bottomRow = -1;
+    for (int column = 0; column < state.columns; column++) {
+        if (frontRows[column] < 0) continue;
+
+        if (state.firstColumn < 0) {
+            state.firstColumn = column;
+        }
+        state.lastColumn = column;
+        state.bottomRow = std::max(state.bottomRow, frontRows[column]);
+    }
+}
+
+float Formation::GetSpeed() const {
+    const int cells = state.columns * state.rows;
+    if (cells == 0) {
+        return moveSpeed;
+    }
+    float killed = (float)(cells - state.alive) / cells;
+    return moveSpeed * (1.0f + (maxSpeedUp - 1.0f) * killed);
+}
+
+void Formation::Step(float deltaTime) {
+    state.previousOffset = state.offset;
+    if (state.alive == 0) {
+        return;
+    }
+
+    state.offset.x += state.direction * GetSpeed() * deltaTime;
+
+    // Only the edge being moved toward counts, so a formation that overshot
+    // turns once rather than bouncing in place
+    const float margin = cellWidth * 0.5f;
+    float left = state.offset.x + GetCellPosition(state.firstColumn, 0).x;
+    float right = state.offset.x + GetCellPosition(state.lastColumn, 0).x;
+    bool atLeft = state.direction < 0.0f && left <= margin;
+    bool atRight = state.direction > 0.0f && right >= config->fieldWidth - margin;
+    if (atLeft || atRight) {
+        state.direction = -state.direction;
+        state.offset.y += dropAmount;
+    }
+}
+
+bool Formation::FindHit(const SDL_FRect& bounds, int& column, int& row) const {
+    if (state.alive == 0 || state.spacing.x <= 0.0f || state.spacing.y <= 0.0f) {
+        return false;
+    }
+
+    // The cells whose enemy could reach the box, in lattice coordinates and
+    // widened by one so rounding never drops a cell the exact test accepts
+    const float halfWidth = cellWidth * 0.5f;
+    const float halfHeight = cellHeight * 0.5f;
+    const float left = bounds.x - state.offset.x - state.origin.x;
+    const float top = bounds.y - state.offset.y - state.origin.y;
+    int firstColumn = std::max((int)std::floor((left - halfWidth) / state.spacing.x), 0);
+    int lastColumn = std::min((int)std::floor((left + bounds.w + halfWidth) / state.spacing.x) + 1, state.columns - 1);
+    int firstRow = std::max((int)std::floor((top - halfHeight) / state.spacing.y), 0);
+    int lastRow = std::min((int)std::floor((top + bounds.h + halfHeight) / state.spacing.y) + 1, state.rows - 1);
+
+    for (int r = lastRow; r >= firstRow; r--) {
+        for (int c = firstColumn; c <= lastColumn; c++) {
+            if (!IsAlive(c, r)) continue;
+
+            // Inclusive, like ForEachOverlap
+            SDL_FPoint center = GetCellPosition(c, r);
+            center.x += state.offset.x;
+            center.y += state.offset.y;
+            if (bounds.x <= center.x + halfWidth && center.x - halfWidth <= bounds.x + bounds.w &&
+                bounds.y <= center.y + halfHeight && center.y - halfHeight <= bounds.y + bounds.h) {
+                column = c;
+                row = r;
+                return true;
+            }
+        }
+    }
+    return false;
+}
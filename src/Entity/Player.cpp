@@ -1,15 +1,12 @@
-#include "../../Entity/Player.h"
-#include "../../Entity/Bullet.h"
+#include "Player.h"
 #include <algorithm>
-#include <iostream>
-#include <memory>
+#include <cstring>
 
-Player::Player(Graphics* graphics) : graphics(graphics) {
+Player::Player(ProjectilePool* projectiles, const GameConfig* config)
+    : projectiles(projectiles), config(config) {
 }
 
 Player::~Player() {
-    // Clean up bullets
-    bullets.clear();
 }
 
 void Player::HandleEvent(const SDL_Event& event) {
@@ -43,15 +40,11 @@ void Player::HandleEvent(const SDL_Event& event) {
                 break;
         }
     }
-    
-    // Debug output to verify key events are being received
-    if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
-        std::cout << "Key event: " << (event.type == SDL_EVENT_KEY_DOWN ? "DOWN" : "UP") 
-                  << " scancode: " << event.key.scancode << std::endl;
-    }
 }
 
 void Player::Update(float deltaTime) {
+    previousPosition = position;
+    
     // Reset velocity
     velocity.x = 0.0f;
     
@@ -68,7 +61,7 @@ void Player::Update(float deltaTime) {
     position.x += velocity.x * deltaTime;
     
     // Constrain player to screen boundaries
-    position.x = std::max(width * 0.5f, std::min(position.x, 800.0f - width * 0.5f));
+    position.x = std::max(width * 0.5f, std::min(position.x, config->fieldWidth - width * 0.5f));
     
     // Handle shooting
     if (isShooting && shootCooldown <= 0.0f) {
@@ -79,58 +72,12 @@ void Player::Update(float deltaTime) {
     if (shootCooldown > 0.0f) {
         shootCooldown -= deltaTime;
     }
-    
-    // Update bullets
-    UpdateBullets(deltaTime);
-}
-
-void Player::Render() {
-    // Draw player ship as a simple rectangle
-    Color playerColor(0, 255, 0);  // Green
-    SDL_FRect playerRect = {
-        position.x - width * 0.5f,
-        position.y - height * 0.5f,
-        width,
-        height
-    };
-    
-    graphics->DrawRect(playerRect, playerColor, true);
-    
-    // Draw a triangle on top to make it look like a ship
-    float triangleHeight = height * 0.5f;
-    graphics->DrawLine(
-        position.x, position.y - height * 0.5f - triangleHeight,
-        position.x - width * 0.5f, position.y - height * 0.5f,
-        playerColor
-    );
-    graphics->DrawLine(
-        position.x, position.y - height * 0.5f - triangleHeight,
-        position.x + width * 0.5f, position.y - height * 0.5f,
-        playerColor
-    );
-    
-    // Render bullets
-    for (auto& bullet : bullets) {
-        bullet->Render();
-    }
-}
-
-void Player::Reset() {
-    // Reset player state
-    lives = 3;
-    position.x = 400.0f;
-    position.y = 550.0f;
-    velocity.x = 0.0f;
-    velocity.y = 0.0f;
-    shootCooldown = 0.0f;
-    
-    // Clear bullets
-    bullets.clear();
 }
 
 void Player::SetPosition(float x, float y) {
     position.x = x;
     position.y = y;
+    previousPosition = position;
 }
 
 SDL_FRect Player::GetBounds() const {
@@ -142,39 +89,46 @@ SDL_FRect Player::GetBounds() const {
     };
 }
 
+Player::State Player::GetState() const {
+    // Zeroed first so that padding never differs between equal states
+    State state;
+    std::memset(&state, 0, sizeof(state));
+    state.position = position;
+    state.previousPosition = previousPosition;
+    state.velocity = velocity;
+    state.shootCooldown = shootCooldown;
+    state.lives = lives;
+    state.moveLeft = moveLeft;
+    state.moveRight = moveRight;
+    state.isShooting = isShooting;
+    return state;
+}
+
+void Player::SetState(const State& state) {
+    position = state.position;
+    previousPosition = state.previousPosition;
+    velocity = state.velocity;
+    shootCooldown = state.shootCooldown;
+    lives = state.lives;
+    moveLeft = state.moveLeft;
+    moveRight = state.moveRight;
+    isShooting = state.isShooting;
+}
+
 void Player::TakeDamage() {
     lives--;
 }
 
 void Player::Shoot() {
-    // Only allow one bullet at a time (like the original game)
-    if (bullets.empty() && shootCooldown <= 0.0f) {
-        auto bullet = std::make_unique<Bullet>(graphics);
-        
+    // Only allow one bullet at a time (like the original game) unless the
+    // config allows more
+    if (projectiles->CountOwned(ProjectileOwner::Player) < config->maxPlayerBullets && shootCooldown <= 0.0f) {
         // Position the bullet at the top center of the player
-        float bulletX = position.x + (width / 2.0f) - (bullet->GetBounds().w / 2.0f);
-        float bulletY = position.y - bullet->GetBounds().h;
-        bullet->SetPosition(bulletX, bulletY);
+        float bulletX = position.x + (width / 2.0f) - (ProjectilePool::width / 2.0f);
+        float bulletY = position.y - ProjectilePool::height;
         
         // Bullet travels upward
-        bullet->SetVelocity(0.0f, -500.0f);
-        
-        bullets.push_back(std::move(bullet));
+        projectiles->Spawn(bulletX, bulletY, 0.0f, -500.0f, ProjectileOwner::Player);
         shootCooldown = 0.2f;
     }
 }
-void Player::UpdateBullets(float deltaTime) {
-    // Update all bullets
-    for (auto& bullet : bullets) {
-        bullet->Update(deltaTime);
-    }
-    
-    // Remove destroyed or out-of-screen bullets
-    bullets.erase(
-        std::remove_if(bullets.begin(), bullets.end(),
-            [](const std::unique_ptr<Bullet>& bullet) { 
-                return bullet->IsDestroyed() || bullet->IsOutOfBounds(); 
-            }),
-        bullets.end()
-    );
-}
@@ -0,0 +1,78 @@
+#include "ProjectilePool.h"
+#include "BinaryStream.h"
+
+ProjectilePool::ProjectilePool(int capacity, float fieldWidth, float fieldHeight)
+    : capacity(capacity), fieldWidth(fieldWidth), fieldHeight(fieldHeight) {
+    store.Reserve(capacity);
+}
+
+ProjectilePool::~ProjectilePool() {
+}
+
+int ProjectilePool::Spawn(float px, float py, float pvx, float pvy, ProjectileOwner who) {
+    if (store.Count() == capacity) {
+        return -1;
+    }
+
+    store.Create(Position{px, py}, PreviousPosition{px, py}, Velocity{pvx, pvy}, who, Alive{1});
+    ownedCount[(int)who]++;
+    return store.Count() - 1;
+}
+
+void ProjectilePool::Clear() {
+    store.Clear();
+    ownedCount[0] = ownedCount[1] = 0;
+}
+
+void ProjectilePool::Save(BinaryWriter& writer) const {
+    writer.Write(store.Count());
+    writer.Write(ownedCount);
+    store.Save(writer);
+}
+
+bool ProjectilePool::Load(BinaryReader& reader) {
+    // The store checks its whole size first, so a short blob leaves the
+    // pool unchanged
+    int savedCount;
+    int savedOwned[2];
+    if (!reader.Read(savedCount) || !reader.Read(savedOwned) || savedCount < 0 || savedCount > capacity ||
+        !store.Load(reader, savedCount)) {
+        return false;
+    }
+    ownedCount[0] = savedOwned[0];
+    ownedCount[1] = savedOwned[1];
+    return true;
+}
+
+void ProjectilePool::Integrate(float deltaTime) {
+    Move(0, store.Count(), deltaTime);
+    RemoveSpent();
+}
+
+void ProjectilePool::Move(int begin, int end, float deltaTime) {
+    Position* position = store.Data<Position>();
+    PreviousPosition* previous = store.Data<PreviousPosition>();
+    const Velocity* velocity = store.Data<Velocity>();
+    for (int i = begin; i < end; i++) {
+        previous[i] = PreviousPosition{position[i].x, position[i].y};
+        position[i].x += velocity[i].x * deltaTime;
+        position[i].y += velocity[i].y * deltaTime;
+    }
+}
+
+void ProjectilePool::RemoveSpent() {
+    const float minX = -width;
+    const float maxX = fieldWidth + width;
+    const float minY = -height;
+    const float maxY = fieldHeight + height;
+
+    store.RemoveIf([&](int i) {
+        const Position& position = store.Get<Position>(i);
+        bool outOfBounds = position.x < minX || position.x > maxX || position.y < minY || position.y > maxY;
+        if (IsAlive(i) && !outOfBounds) {
+            return false;
+        }
+        ownedCount[(int)GetOwner(i)]--;
+        return true;
+    });
+}
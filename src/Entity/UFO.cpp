@@ -1,12 +1,10 @@
-#include "../../Entity/UFO.h"
-#include <random>
+#include "UFO.h"
+#include "Random.h"
+#include <cstring>
 
-UFO::UFO(Graphics* graphics) : graphics(graphics) {
+UFO::UFO(const GameConfig* config, Uint64 id) : config(config), id(id) {
     // Initialize with random spawn timer
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dist(5.0f, spawnInterval);
-    spawnTimer = dist(gen);
+    spawnTimer = NextSpawnTime(5.0f);
     
     // UFO starts inactive
     active = false;
@@ -28,54 +26,59 @@ void UFO::Update(float deltaTime) {
             // Start off-screen to the left
             position.x = -width;
             position.y = 50.0f;
+            previousPosition = position;
             velocity.x = 150.0f;  // Move right
             
             // Reset timer for next spawn
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_real_distribution<float> dist(10.0f, spawnInterval);
-            spawnTimer = dist(gen);
+            spawnTimer = NextSpawnTime(10.0f);
         }
     } else {
+        previousPosition = position;
+        
         // Update position
         position.x += velocity.x * deltaTime;
         
         // Check if UFO has moved off-screen
-        if (position.x > 800 + width) {
+        if (position.x > config->fieldWidth + width) {
             active = false;
         }
     }
 }
 
-void UFO::Render() {
-    if (!active || destroyed) return;
-    
-    // Draw UFO as an ellipse (approximated with a rectangle)
-    Color ufoColor(255, 0, 255);  // Purple
-    SDL_FRect ufoRect = {
-        position.x - width * 0.5f,
-        position.y - height * 0.5f,
-        width,
-        height
-    };
-    
-    graphics->DrawRect(ufoRect, ufoColor, true);
-    
-    // Draw a "cockpit" in the middle
-    Color cockpitColor(150, 150, 255);  // Light blue
-    SDL_FRect cockpitRect = {
-        position.x - width * 0.2f,
-        position.y - height * 0.25f,
-        width * 0.4f,
-        height * 0.5f
-    };
-    
-    graphics->DrawRect(cockpitRect, cockpitColor, true);
+float UFO::NextSpawnTime(float minimum) {
+    return RandomRange(config->seed, id, spawns++, minimum, spawnInterval);
+}
+
+UFO::State UFO::GetState() const {
+    // Zeroed first so that padding never differs between equal states
+    State state;
+    std::memset(&state, 0, sizeof(state));
+    state.id = id;
+    state.spawns = spawns;
+    state.position = position;
+    state.previousPosition = previousPosition;
+    state.velocity = velocity;
+    state.spawnTimer = spawnTimer;
+    state.destroyed = destroyed;
+    state.active = active;
+    return state;
+}
+
+void UFO::SetState(const State& state) {
+    id = state.id;
+    spawns = state.spawns;
+    position = state.position;
+    previousPosition = state.previousPosition;
+    velocity = state.velocity;
+    spawnTimer = state.spawnTimer;
+    destroyed = state.destroyed;
+    active = state.active;
 }
 
 void UFO::SetPosition(float x, float y) {
     position.x = x;
     position.y = y;
+    previousPosition = position;
 }
 
 SDL_FRect UFO::GetBounds() const {
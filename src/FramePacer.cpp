@@ -0,0 +1,79 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer(int targetFPS)
+    : periodNS(targetFPS > 0 ? SDL_NS_PER_SECOND / targetFPS : 0) {
+}
+
+void FramePacer::Sleep(Uint64 now) {
+    Uint64 requested = deadline - now - spinNS;
+    SDL_DelayNS(requested);
+    Uint64 woke = SDL_GetTicksNS();
+    sleptNS += woke - now;
+
+    // Jump to a new worst oversleep at once, with some headroom, and let
+    // the margin shrink back slowly while sleeps are accurate
+    Uint64 overshoot = woke - now > requested ? woke - now - requested : 0;
+    spinNS = std::max(overshoot + overshoot / 4, spinNS - spinNS / 16);
+    spinNS = std::clamp(spinNS, minSpinNS, maxSpinNS);
+}
+
+void FramePacer::Wait() {
+    Uint64 now = SDL_GetTicksNS();
+
+    if (periodNS > 0) {
+        if (deadline == 0) {
+            deadline = now + periodNS;
+        }
+
+        if (now < deadline && deadline - now > spinNS) {
+            Sleep(now);
+            now = SDL_GetTicksNS();
+        }
+        Uint64 spinStart = now;
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = SDL_GetTicksNS();
+        }
+        spunNS += now - spinStart;
+        if (now - deadline > periodNS / 2) {
+            missed++;
+        }
+
+        // After falling more than a whole period behind, start the schedule
+        // again from now instead of rushing the next frames out
+        deadline += periodNS;
+        if (deadline <= now) {
+            deadline = now + periodNS;
+        }
+    }
+
+    if (lastFrame != 0) {
+        double interval = (double)(now - lastFrame);
+        frames++;
+        intervalSum += interval;
+        intervalSquares += interval * interval;
+        if (periodNS > 0) {
+            worstError = std::max(worstError, std::fabs(interval - (double)periodNS));
+        }
+    }
+    lastFrame = now;
+}
+
+FramePacingStats FramePacer::GetStats() const {
+    FramePacingStats stats;
+    stats.frames = frames;
+    stats.missed = missed;
+    stats.sleptMS = sleptNS / 1e6;
+    stats.spunMS = spunNS / 1e6;
+    if (frames > 0) {
+        double mean = intervalSum / frames;
+        double variance = std::max(0.0, intervalSquares / frames - mean * mean);
+        stats.meanMS = mean / 1e6;
+        stats.jitterMS = std::sqrt(variance) / 1e6;
+        stats.worstErrorMS = worstError / 1e6;
+    }
+    return stats;
+}
@@ -0,0 +1,39 @@
+#include "FrameProfiler.h"
+
+const char* GetFramePhaseName(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::Events:     return "EVENTS";
+        case FramePhase::Update:     return "UPDATE";
+        case FramePhase::Collisions: return "COLLISIONS";
+        case FramePhase::Render:     return "RENDER";
+        case FramePhase::Present:    return "PRESENT";
+        default:                     return "?";
+    }
+}
+
+void FrameProfiler::EndFrame() {
+    Uint64 now = SDL_GetTicksNS();
+
+    // The first call only marks where frame timing starts
+    if (lastFrameEnd != 0) {
+        current.frameNS = now - lastFrameEnd;
+        history[next] = current;
+        next = (next + 1) % historySize;
+        if (count < historySize) {
+            count++;
+        }
+    }
+
+    current = FrameTiming();
+    lastFrameEnd = now;
+}
+
+FrameTiming FrameProfiler::TakeCurrent() {
+    FrameTiming taken = current;
+    current = FrameTiming();
+    return taken;
+}
+
+const FrameTiming& FrameProfiler::GetFrame(int age) const {
+    return history[(next - 1 - age + historySize) % historySize];
+}
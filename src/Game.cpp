@@ -1,18 +1,13 @@
 #include "Game.h"
-#include "../include/Graphics.h"
-#include "TextRenderer.h"
 #include "Player.h"
-#include "Enemy.h"
-#include "Bullet.h"
 #include "Barrier.h"
 #include "UFO.h"
+#include "Random.h"
+#include "Replay.h"
+#include "Log.h"
 #include <algorithm>
-#include <iostream>
-#include <sstream>
-#include <iomanip>
 
-Game::Game(SDL_Window* window, SDL_Renderer* renderer)
-    : window(window), renderer(renderer) {
+Game::Game(const GameConfig& config) : config(config) {
 }
 
 Game::~Game() {
@@ -20,24 +15,15 @@ Game::~Game() {
 }
 
 void Game::Initialize() {
-    // Create graphics
-    Graphics* graphics = new Graphics(renderer);
-    
-    // Create text renderer
-    textRenderer = std::make_unique<TextRenderer>(graphics, renderer);
-    
-    // Attempt to load a font (falls back to primitive rendering if not found)
-    textRenderer->LoadFont("assets/fonts/DejaVuSans.ttf", 24);
-    
     // Create player
-    player = std::make_unique<Player>(graphics);
-    player->SetPosition(400.0f, 550.0f);
+    player = std::make_unique<Player>(&projectiles, &config);
+    player->SetPosition(config.fieldWidth * 0.5f, config.PlayerY());
     
     // Create barriers
     CreateBarriers();
     
     // Create UFO
-    ufo = std::make_unique<UFO>(new Graphics(renderer));
+    ufo = std::make_unique<UFO>(&config, nextEntityId++);
     
     // Initial enemy spawn
     SpawnEnemies();
@@ -46,24 +32,26 @@ void Game::Initialize() {
     gameOver = false;
     score = 0;
     level = 1;
+    
+    SaveSnapshot(pristineSnapshot);
 }
 
 void Game::HandleEvent(const SDL_Event& event) {
+    if (recorder) {
+        recorder->RecordEvent(tick, event);
+    }
+    
     // Handle game-specific events
     if (event.type == SDL_EVENT_KEY_DOWN) {
         // In SDL3, key code handling is different
         if (event.key.scancode == SDL_SCANCODE_R && gameOver) {
             // Reset game on 'R' press when game over
-            gameOver = false;
-            if (score > highScore) {
-                highScore = score;
-            }
-            score = 0;
-            level = 1;
-            enemies.clear();
-            CreateBarriers(); // Recreate barriers
-            SpawnEnemies();
-            player->Reset();
+            StartOver();
+        }
+        
+        // Toggle the performance overlay
+        if (event.key.scancode == SDL_SCANCODE_F3 && !event.key.repeat) {
+            showPerfOverlay = !showPerfOverlay;
         }
     }
     
@@ -73,7 +61,46 @@ void Game::HandleEvent(const SDL_Event& event) {
     }
 }
 
+void Game::Restart() {
+    if (recorder) {
+        recorder->RecordRestart(tick);
+    }
+    StartOver();
+}
+
+void Game::StartOver() {
+    // Restore the first board instead of rebuilding it, keeping the high
+    // score, the tick count and the keys the player is holding
+    const int best = std::max(score, highScore);
+    const Uint64 now = tick;
+    const Player::State held = player->GetState();
+    
+    LoadSnapshot(pristineSnapshot.data(), pristineSnapshot.size());
+    
+    highScore = best;
+    tick = now;
+    Player::State fresh = player->GetState();
+    fresh.moveLeft = held.moveLeft;
+    fresh.moveRight = held.moveRight;
+    fresh.isShooting = held.isShooting;
+    player->SetState(fresh);
+}
+
+void Game::AdvanceLevel() {
+    enemies.Clear();
+    level++;
+    SpawnEnemies();
+    LOG_DEBUG(Game, "Level %d: %d enemies", level, enemies.Count());
+}
+
 void Game::Update(float deltaTime) {
+    PROFILE_PHASE(simulationProfiler, FramePhase::Update);
+    
+    if (recorder) {
+        recorder->BeginTick(*this);
+    }
+    const Uint64 thisTick = tick++;
+    
     if (gameOver || !player) {
         return;
     }
@@ -83,10 +110,18 @@ void Game::Update(float deltaTime) {
     // Update player
     player->Update(deltaTime);
     
-    // Update enemies
-    for (auto& enemy : enemies) {
-        enemy->Update(deltaTime);
-    }
+    // Move the formation, then decide who fires. Each fire roll depends only
+    // on the seed, the enemy and the tick, so the result is the same however
+    // the formation is split across threads.
+    enemies.Move(deltaTime);
+    const int enemyCount = enemies.Count();
+    fireRolls.resize(enemyCount);
+    jobs.ParallelFor(enemyCount, enemyGrain, [&](int begin, int end) {
+        enemies.DecideFire(begin, end, deltaTime, thisTick, fireRolls.data() + begin);
+    });
+    
+    // Spawn the bullets the enemies decided to fire, in row order
+    enemies.Fire(projectiles);
     
     // Update barriers
     for (auto& barrier : barriers) {
@@ -98,220 +133,131 @@ void Game::Update(float deltaTime) {
         ufo->Update(deltaTime);
     }
     
-    // Remove destroyed enemies
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [](const std::unique_ptr<Enemy>& enemy) { return enemy->IsDestroyed(); }),
-        enemies.end()
-    );
+    // Move every bullet and drop the spent ones
+    jobs.ParallelFor(projectiles.Count(), projectileGrain, [&](int begin, int end) {
+        projectiles.Move(begin, end, deltaTime);
+    });
+    projectiles.RemoveSpent();
     
     // Check for game over condition
     if (player->IsDestroyed()) {
         gameOver = true;
-        std::cout << "Game Over! Final Score: " << score << std::endl;
+        LOG_INFO(Game, "Game Over! Final Score: %d", score);
         return;
     }
     
     // Check if all enemies are destroyed
-    if (enemies.empty()) {
+    if (enemies.Count() == 0) {
         // Increase level and spawn new enemies
-        level++;
-        SpawnEnemies();
+        AdvanceLevel();
     }
     
     // Check for collisions
     CheckCollisions();
 }
 
-void Game::RenderScore() {
-    // Render score at the top of the screen
-    std::stringstream ss;
-    ss << "SCORE: " << score << "   HIGH SCORE: " << highScore << "   LEVEL: " << level;
-    textRenderer->DrawText(ss.str(), 400.0f, 20.0f, Color(255, 255, 255), true);
+void Game::SpawnEnemies() {
+    const int rowCount = config.FormationRows(level); // More rows with higher levels
+    const int colCount = config.formationColumns;
+    
+    enemies.Form(colCount, rowCount,
+                 SDL_FPoint{config.formationStartX, config.formationStartY},
+                 SDL_FPoint{config.formationSpacingX, config.formationSpacingY},
+                 nextEntityId);
+    nextEntityId += (Uint64)enemies.Count();
 }
 
-void Game::Render() {
-    // Clear screen
-    SDL_SetRenderDrawColor(renderer, 0, 0, 30, 255);
-    SDL_RenderClear(renderer);
-    
-    // Render player
-    if (player && !player->IsDestroyed()) {
-        player->Render();
-    }
-    
-    // Render enemies
-    for (auto& enemy : enemies) {
-        enemy->Render();
-    }
-    
-    // Render barriers
-    for (auto& barrier : barriers) {
-        barrier->Render();
-    }
-    
-    // Render UFO
-    if (ufo) {
-        ufo->Render();
-    }
+void Game::CreateBarriers() {
+    barriers.clear();
     
-    // Render score
-    RenderScore();
+    // Create a row of barriers (4 in the normal field)
+    const float barrierY = config.BarrierY();
     
-    // Render game over message if needed
-    if (gameOver) {
-        // Game over overlay
-        SDL_SetRenderDrawColor(renderer, 50, 0, 0, 180);
-        SDL_FRect overlay = {0, 0, 800, 600};
-        SDL_RenderFillRect(renderer, &overlay);
-        
-        // Game over text
-        textRenderer->DrawText("GAME OVER", 400.0f, 250.0f, Color(255, 255, 255), true);
-        textRenderer->DrawText("PRESS R TO RESTART", 400.0f, 300.0f, Color(255, 255, 255), true);
-        
-        std::stringstream ss;
-        ss << "FINAL SCORE: " << score;
-        textRenderer->DrawText(ss.str(), 400.0f, 350.0f, Color(255, 255, 255), true);
+    for (int i = 0; i < config.barrierCount; i++) {
+        float x = config.barrierStartX + i * config.barrierSpacing;
+        barriers.push_back(std::make_unique<Barrier>(x, barrierY));
     }
-    
-    // Present the rendered frame
-    SDL_RenderPresent(renderer);
 }
 
-void Game::SpawnEnemies() {
-    const int rowCount = 3 + (level - 1) / 2; // More rows with higher levels
-    const int colCount = 8;
-    const float startX = 100.0f;
-    const float startY = 50.0f;
-    const float spacingX = 70.0f;
-    const float spacingY = 50.0f;
-    
-    // Make sure we create a Graphics object that persists
-    Graphics* graphics = new Graphics(renderer);
-    
-    for (int row = 0; row < rowCount; row++) {
-        for (int col = 0; col < colCount; col++) {
-            auto enemy = std::make_unique<Enemy>(graphics);
-            enemy->SetPosition(
-                startX + col * spacingX,
-                startY + row * spacingY
-            );
-            enemies.push_back(std::move(enemy));
+bool Game::HitBarriers(int projectile) {
+    SDL_FRect bulletRect = projectiles.GetBounds(projectile);
+    float vy = projectiles.GetVelocity(projectile).y;
+    
+    for (auto& barrier : barriers) {
+        if (barrier->Hit(bulletRect, vy)) {
+            projectiles.Kill(projectile);
+            return true;
         }
     }
+    return false;
 }
 
-void Game::CreateBarriers() {
-    barriers.clear();
+void Game::CheckCollisions() {
+    PROFILE_PHASE(simulationProfiler, FramePhase::Collisions);
     
-    // Create 4 barriers
-    const int barrierCount = 4;
-    const float barrierY = 450.0f;
-    const float spacing = 160.0f;
-    const float startX = 150.0f;
+    if (player == nullptr || gameOver) return;
     
-    for (int i = 0; i < barrierCount; i++) {
-        float x = startX + i * spacing;
-        barriers.push_back(std::make_unique<Barrier>(new Graphics(renderer), x, barrierY));
+    projectileBoxes.Clear();
+    for (int i = 0; i < projectiles.Count(); i++) {
+        projectileBoxes.Add(projectiles.GetBounds(i));
     }
-}
-
-void Game::CheckCollisions() {
-    if (player == nullptr || gameOver) return;
     
-    // Get player bullets
-    const auto& playerBullets = player->GetBullets();
-    
-    // Check collision between player bullets and enemies
-    for (auto& enemy : enemies) {
-        for (auto& bullet : playerBullets) {
-            if (!bullet->IsDestroyed() && !enemy->IsDestroyed()) {
-                SDL_FRect bulletRect = bullet->GetBounds();
-                SDL_FRect enemyRect = enemy->GetBounds();
-                
-                if (SDL_HasRectIntersectionFloat(&bulletRect, &enemyRect)) {
-                    enemy->Destroy();
-                    bullet->Destroy();
-                    score += 10 * level; // More points in higher levels
-                }
-            }
-        }
-        
-        // Check collision between enemy and player (if enemy reaches bottom)
-        if (!enemy->IsDestroyed() && enemy->GetPosition().y > 500) {
-            player->Destroy();
-            gameOver = true;
-        }
-        
-        // Check collision between enemy bullets and player
-        const auto& enemyBullets = enemy->GetBullets();
-        for (auto& bullet : enemyBullets) {
-            if (!bullet->IsDestroyed() && !player->IsDestroyed()) {
-                SDL_FRect bulletRect = bullet->GetBounds();
-                SDL_FRect playerRect = player->GetBounds();
-                
-                if (SDL_HasRectIntersectionFloat(&bulletRect, &playerRect)) {
-                    player->TakeDamage();
-                    bullet->Destroy();
-                    if (player->IsDestroyed()) {
-                        gameOver = true;
-                    }
-                }
+    // Check collision between enemy and player (if enemy reaches bottom).
+    // The formation keeps its lowest alive row, so this is one comparison.
+    if (enemies.Count() > 0 && enemies.GetFormation().GetBottom() > config.InvasionLineY()) {
+        player->Destroy();
+        gameOver = true;
+    }
+    
+    // Check collision between enemy bullets and player
+    if (!player->IsDestroyed()) {
+        ForEachOverlap(player->GetBounds(), projectileBoxes, [&](int i) {
+            if (!projectiles.IsAlive(i) || projectiles.GetOwner(i) != ProjectileOwner::Enemy) {
+                return false;
             }
-            
-            // Check collision between enemy bullets and barriers
-            if (!bullet->IsDestroyed()) {
-                for (auto& barrier : barriers) {
-                    const auto& bricks = barrier->GetBricks();
-                    SDL_FRect bulletRect = bullet->GetBounds();
-                    
-                    for (size_t i = 0; i < bricks.size(); i++) {
-                        if (!bricks[i].destroyed) {
-                            if (SDL_HasRectIntersectionFloat(&bulletRect, &bricks[i].rect)) {
-                                barrier->DamageBrick(i);
-                                bullet->Destroy();
-                                break;
-                            }
-                        }
-                    }
-                }
+            player->TakeDamage();
+            projectiles.Kill(i);
+            if (player->IsDestroyed()) {
+                gameOver = true;
+                return true;
             }
-        }
+            return false;
+        });
     }
     
-    // Check collision between player bullets and barriers
-    for (auto& bullet : playerBullets) {
-        if (!bullet->IsDestroyed()) {
-            for (auto& barrier : barriers) {
-                const auto& bricks = barrier->GetBricks();
-                SDL_FRect bulletRect = bullet->GetBounds();
-                
-                for (size_t i = 0; i < bricks.size(); i++) {
-                    if (!bricks[i].destroyed) {
-                        if (SDL_HasRectIntersectionFloat(&bulletRect, &bricks[i].rect)) {
-                            barrier->DamageBrick(i);
-                            bullet->Destroy();
-                            break;
-                        }
-                    }
-                }
+    for (int i = 0; i < projectiles.Count(); i++) {
+        if (!projectiles.IsAlive(i)) continue;
+        
+        if (projectiles.GetOwner(i) == ProjectileOwner::Player) {
+            // Check collision between player bullets and enemies: the bullet
+            // maps straight onto the formation's cells
+            int enemy = enemies.FindHit(projectiles.GetBounds(i));
+            if (enemy >= 0) {
+                enemies.Kill(enemy);
+                projectiles.Kill(i);
+                score += 10 * level; // More points in higher levels
             }
         }
+        
+        // Check collision between bullets and barriers
+        if (projectiles.IsAlive(i)) {
+            HitBarriers(i);
+        }
     }
     
     // Check collision between player bullets and UFO
     if (ufo && ufo->IsActive() && !ufo->IsDestroyed()) {
-        for (auto& bullet : playerBullets) {
-            if (!bullet->IsDestroyed()) {
-                SDL_FRect bulletRect = bullet->GetBounds();
-                SDL_FRect ufoRect = ufo->GetBounds();
-                
-                if (SDL_HasRectIntersectionFloat(&bulletRect, &ufoRect)) {
-                    ufo->Destroy();
-                    bullet->Destroy();
-                    score += ufo->GetScoreValue() * level;
-                }
+        ForEachOverlap(ufo->GetBounds(), projectileBoxes, [&](int i) {
+            if (!projectiles.IsAlive(i) || projectiles.GetOwner(i) != ProjectileOwner::Player) {
+                return false;
             }
-        }
+            ufo->Destroy();
+            projectiles.Kill(i);
+            score += ufo->GetScoreValue() * level;
+            return true;
+        });
     }
+    
+    // Swap-and-pop the enemies hit this tick; the rows above are no longer valid
+    enemies.RemoveDead();
 }
@@ -0,0 +1,224 @@
+#include "Game.h"
+#include "Player.h"
+#include "Barrier.h"
+#include "UFO.h"
+#include "BinaryStream.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstring>
+
+// A snapshot is a SnapshotHeader followed by its sections. The header's
+// table gives each section's offset and entry count, and every section
+// starts on an 8-byte boundary, so a mapped file can be used in place.
+// Entries are stored exactly as they are in memory; bump the version
+// whenever any of the State structs, the components or the layout changes.
+static const uint32_t SNAPSHOT_MAGIC = 0x53564E49;  // "INVS"
+static const uint32_t SNAPSHOT_VERSION = 5;
+static const size_t SNAPSHOT_ALIGNMENT = 8;
+
+enum SnapshotSectionId {
+    ConfigSection,      // One GameConfig
+    ScalarsSection,     // One SnapshotScalars
+    PlayerSection,      // One Player::State
+    UfoSection,         // One UFO::State
+    FormationSection,   // One Formation::State; the alive cells are the enemies' cells
+    EnemySection,       // The enemy archetype's columns; count is the enemy count
+    BarrierSection,     // Barrier::State per barrier
+    ProjectileSection,  // ProjectilePool::Save output; count is the projectile count
+    SnapshotSectionCount
+};
+
+struct SnapshotSection {
+    uint32_t offset;
+    uint32_t count;
+};
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;  // Whole snapshot, header included
+    uint32_t sectionCount;
+    SnapshotSection sections[SnapshotSectionCount];
+};
+
+struct SnapshotScalars {
+    Uint64 tick;
+    Uint64 nextEntityId;
+    float gameTime;
+    int score;
+    int highScore;
+    int level;
+    uint8_t gameOver;
+    uint8_t padding[7];
+};
+
+// Bytes a section of count entries of itemSize must hold
+static const size_t sectionItemSizes[SnapshotSectionCount] = {
+    sizeof(GameConfig),
+    sizeof(SnapshotScalars),
+    sizeof(Player::State),
+    sizeof(UFO::State),
+    sizeof(Formation::State),
+    Enemies::Store::rowSize,
+    sizeof(Barrier::State),
+    0  // Variable; checked by ProjectilePool::Load
+};
+
+static void BeginSection(std::vector<Uint8>& out, SnapshotHeader& header, SnapshotSectionId id, size_t count) {
+    out.resize((out.size() + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT, 0);
+    header.sections[id].offset = (uint32_t)out.size();
+    header.sections[id].count = (uint32_t)count;
+}
+
+// Checks the header and every section's bounds; false if data is not a
+// snapshot this build can read
+static bool ReadHeader(const Uint8* data, size_t size, SnapshotHeader& header) {
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+        header.sectionCount != SnapshotSectionCount || header.size > size) {
+        return false;
+    }
+    for (int id = 0; id < SnapshotSectionCount; id++) {
+        const SnapshotSection& section = header.sections[id];
+        if (section.offset % SNAPSHOT_ALIGNMENT != 0 || section.offset > header.size ||
+            (uint64_t)section.count * sectionItemSizes[id] > header.size - section.offset) {
+            return false;
+        }
+    }
+    return header.sections[ConfigSection].count == 1 && header.sections[ScalarsSection].count == 1 &&
+           header.sections[PlayerSection].count == 1 && header.sections[UfoSection].count == 1 &&
+           header.sections[FormationSection].count == 1;
+}
+
+template <typename T>
+static T ReadEntry(const Uint8* data, const SnapshotSection& section, size_t index = 0) {
+    T value;
+    std::memcpy(&value, data + section.offset + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+void Game::SaveSnapshot(std::vector<Uint8>& out) const {
+    out.clear();
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = SnapshotSectionCount;
+    out.resize(sizeof(header));
+    BinaryWriter writer(out);
+
+    // Everything before workerThreads, which cannot change the result. The
+    // rest stays zeroed so that equal configs always save equal bytes.
+    static_assert(offsetof(GameConfig, workerThreads) + sizeof(int) + alignof(GameConfig) > sizeof(GameConfig),
+                  "workerThreads must stay the last GameConfig field");
+    GameConfig savedConfig;
+    std::memset(&savedConfig, 0, sizeof(savedConfig));
+    std::memcpy(&savedConfig, &config, offsetof(GameConfig, workerThreads));
+    BeginSection(out, header, ConfigSection, 1);
+    writer.Write(savedConfig);
+
+    SnapshotScalars scalars{};
+    scalars.tick = tick;
+    scalars.nextEntityId = nextEntityId;
+    scalars.gameTime = gameTime;
+    scalars.score = score;
+    scalars.highScore = highScore;
+    scalars.level = level;
+    scalars.gameOver = gameOver;
+    BeginSection(out, header, ScalarsSection, 1);
+    writer.Write(scalars);
+
+    BeginSection(out, header, PlayerSection, 1);
+    writer.Write(player->GetState());
+    BeginSection(out, header, UfoSection, 1);
+    writer.Write(ufo->GetState());
+    BeginSection(out, header, FormationSection, 1);
+    writer.Write(enemies.GetFormation().GetState());
+
+    BeginSection(out, header, EnemySection, enemies.Count());
+    enemies.GetStore().Save(writer);
+    BeginSection(out, header, BarrierSection, barriers.size());
+    for (const auto& barrier : barriers) {
+        writer.Write(barrier->GetState());
+    }
+    BeginSection(out, header, ProjectileSection, projectiles.Count());
+    projectiles.Save(writer);
+
+    header.size = (uint32_t)out.size();
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool Game::ReadSnapshotConfig(const Uint8* data, size_t size, GameConfig& snapshotConfig) {
+    SnapshotHeader header;
+    if (!ReadHeader(data, size, header)) {
+        return false;
+    }
+    snapshotConfig = ReadEntry<GameConfig>(data, header.sections[ConfigSection]);
+    return true;
+}
+
+bool Game::LoadSnapshot(const Uint8* data, size_t size) {
+    SnapshotHeader header;
+    if (!ReadHeader(data, size, header) || !player || !ufo) {
+        return false;
+    }
+
+    // The layout and the seed must match; the thread count may differ
+    GameConfig saved = ReadEntry<GameConfig>(data, header.sections[ConfigSection]);
+    if (saved.fieldWidth != config.fieldWidth || saved.fieldHeight != config.fieldHeight ||
+        saved.projectileCapacity != config.projectileCapacity || saved.seed != config.seed) {
+        return false;
+    }
+
+    // Last, since it is the only part that can still fail
+    const SnapshotSection& pool = header.sections[ProjectileSection];
+    BinaryReader poolReader(data + pool.offset, header.size - pool.offset);
+    if (!projectiles.Load(poolReader)) {
+        return false;
+    }
+
+    SnapshotScalars scalars = ReadEntry<SnapshotScalars>(data, header.sections[ScalarsSection]);
+    tick = scalars.tick;
+    nextEntityId = scalars.nextEntityId;
+    gameTime = scalars.gameTime;
+    score = scalars.score;
+    highScore = scalars.highScore;
+    level = scalars.level;
+    gameOver = scalars.gameOver != 0;
+
+    player->SetState(ReadEntry<Player::State>(data, header.sections[PlayerSection]));
+    ufo->SetState(ReadEntry<UFO::State>(data, header.sections[UfoSection]));
+
+    // Cannot fail: ReadHeader checked the section holds every row
+    const SnapshotSection& enemySection = header.sections[EnemySection];
+    BinaryReader enemyReader(data + enemySection.offset, header.size - enemySection.offset);
+    enemies.GetStore().Load(enemyReader, (int)enemySection.count);
+    enemies.RestoreFormation(ReadEntry<Formation::State>(data, header.sections[FormationSection]));
+
+    // Reuse the barriers already allocated where there are enough
+    const SnapshotSection& barrierSection = header.sections[BarrierSection];
+    barriers.resize(barrierSection.count);
+    for (uint32_t i = 0; i < barrierSection.count; i++) {
+        Barrier::State state = ReadEntry<Barrier::State>(data, barrierSection, i);
+        if (!barriers[i]) {
+            barriers[i] = std::make_unique<Barrier>(state.position.x, state.position.y);
+        }
+        barriers[i]->SetState(state);
+    }
+    return true;
+}
+
+bool Game::SaveSnapshotFile(const std::string& path) const {
+    std::vector<Uint8> snapshot;
+    SaveSnapshot(snapshot);
+
+    MappedFile file;
+    if (!file.Create(path, snapshot.size())) {
+        return false;
+    }
+    std::memcpy(file.Data(), snapshot.data(), snapshot.size());
+    return true;
+}
@@ -1,5 +1,6 @@
 #include "../include/Graphics.h"
-#include <iostream>
+#include "Log.h"
+#include <cmath>
 
 Graphics::Graphics(SDL_Renderer* renderer)
     : renderer(renderer) {
@@ -7,61 +8,283 @@ Graphics::Graphics(SDL_Renderer* renderer)
 
 Graphics::~Graphics() {
     // Clean up texture cache
-    for (auto& [path, texture] : textureCache) {
-        SDL_DestroyTexture(texture);
+    for (auto& entry : textures) {
+        DestroyEntryTexture(entry);
     }
-    textureCache.clear();
+    textures.clear();
 }
 
 void Graphics::Clear(const Color& color) {
+    // Anything still queued would be painted over anyway
+    vertices.clear();
+    indices.clear();
+    
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(renderer);
+    frameStats.drawCalls++;
 }
 
 void Graphics::Present() {
+    Flush();
     SDL_RenderPresent(renderer);
+    
+    lastFrameStats = frameStats;
+    frameStats = RenderStats();
+    boundTexture = nullptr;
+    frame++;
+}
+
+void Graphics::SetRenderTarget(SDL_Texture* target) {
+    // Queued primitives belong to the current target
+    Flush();
+    SDL_SetRenderTarget(renderer, target);
+}
+
+void Graphics::Flush() {
+    if (indices.empty()) {
+        return;
+    }
+    
+    SDL_RenderGeometry(renderer, nullptr, vertices.data(), (int)vertices.size(),
+                       indices.data(), (int)indices.size());
+    CountDrawCall(nullptr);
+    
+    vertices.clear();
+    indices.clear();
+}
+
+void Graphics::CountDrawCall(SDL_Texture* texture) {
+    frameStats.drawCalls++;
+    if (texture != boundTexture) {
+        frameStats.stateChanges++;
+        boundTexture = texture;
+    }
+}
+
+void Graphics::QueueQuad(const SDL_FPoint corners[4], const Color& color) {
+    SDL_FColor fcolor = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    
+    int base = (int)vertices.size();
+    for (int i = 0; i < 4; i++) {
+        vertices.push_back(SDL_Vertex{ corners[i], fcolor, SDL_FPoint{0.0f, 0.0f} });
+    }
+    
+    // Two triangles: 0-1-2 and 0-2-3
+    const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int i : quad) {
+        indices.push_back(base + i);
+    }
 }
 
 void Graphics::DrawRect(const SDL_FRect& rect, const Color& color, bool filled) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    frameStats.primitives++;
     
     if (filled) {
-        SDL_RenderFillRect(renderer, &rect);
-    } else {
-        SDL_RenderRect(renderer, &rect);
+        SDL_FPoint corners[4] = {
+            { rect.x, rect.y },
+            { rect.x + rect.w, rect.y },
+            { rect.x + rect.w, rect.y + rect.h },
+            { rect.x, rect.y + rect.h }
+        };
+        QueueQuad(corners, color);
+        return;
+    }
+    
+    // Outline: four one-pixel strips inside the rect, like SDL_RenderRect
+    const SDL_FRect edges[4] = {
+        { rect.x, rect.y, rect.w, 1.0f },
+        { rect.x, rect.y + rect.h - 1.0f, rect.w, 1.0f },
+        { rect.x, rect.y + 1.0f, 1.0f, rect.h - 2.0f },
+        { rect.x + rect.w - 1.0f, rect.y + 1.0f, 1.0f, rect.h - 2.0f }
+    };
+    for (const auto& edge : edges) {
+        SDL_FPoint corners[4] = {
+            { edge.x, edge.y },
+            { edge.x + edge.w, edge.y },
+            { edge.x + edge.w, edge.y + edge.h },
+            { edge.x, edge.y + edge.h }
+        };
+        QueueQuad(corners, color);
     }
 }
 
 void Graphics::DrawLine(float x1, float y1, float x2, float y2, const Color& color) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderLine(renderer, x1, y1, x2, y2);
+    frameStats.primitives++;
+    
+    // A one-pixel-wide quad along the line
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
+    
+    float nx = -dy / length * 0.5f;
+    float ny = dx / length * 0.5f;
+    SDL_FPoint corners[4] = {
+        { x1 + nx, y1 + ny },
+        { x2 + nx, y2 + ny },
+        { x2 - nx, y2 - ny },
+        { x1 - nx, y1 - ny }
+    };
+    QueueQuad(corners, color);
 }
 
-SDL_Texture* Graphics::LoadTexture(const std::string& path) {
-    // Check if texture is already loaded
-    auto it = textureCache.find(path);
-    if (it != textureCache.end()) {
-        return it->second;
+TextureHandle Graphics::AllocateHandle() {
+    if (!freeHandles.empty()) {
+        TextureHandle handle = freeHandles.back();
+        freeHandles.pop_back();
+        return handle;
     }
-    
-    // Load the texture
-    SDL_Surface* surface = SDL_LoadBMP(path.c_str());
-    if (!surface) {
-        std::cerr << "Unable to load image " << path << "! SDL Error: " << SDL_GetError() << std::endl;
+    textures.emplace_back();
+    return (TextureHandle)textures.size();
+}
+
+Graphics::TextureEntry* Graphics::FindEntry(TextureHandle handle) {
+    if (handle == InvalidTexture || handle > textures.size()) {
         return nullptr;
     }
+    TextureEntry& entry = textures[handle - 1];
+    return entry.inUse ? &entry : nullptr;
+}
+
+bool Graphics::LoadEntry(TextureEntry& entry) {
+    SDL_Surface* surface = SDL_LoadBMP(entry.path.c_str());
+    if (!surface) {
+        LOG_ERROR(Assets, "Unable to load image %s! SDL Error: %s", entry.path.c_str(), SDL_GetError());
+        return false;
+    }
     
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    // Estimate: textures are uploaded as 32-bit texels
+    size_t bytes = (size_t)surface->w * surface->h * 4;
     SDL_DestroySurface(surface);
     
     if (!texture) {
-        std::cerr << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR(Assets, "Unable to create texture from %s! SDL Error: %s", entry.path.c_str(), SDL_GetError());
+        return false;
+    }
+    
+    entry.texture = texture;
+    entry.bytes = bytes;
+    entry.lastUsedFrame = frame;
+    textureStats.resident++;
+    textureStats.residentBytes += bytes;
+    textureStats.loads++;
+    
+    TrimTextures();
+    return true;
+}
+
+void Graphics::DestroyEntryTexture(TextureEntry& entry) {
+    if (!entry.texture) {
+        return;
+    }
+    SDL_DestroyTexture(entry.texture);
+    entry.texture = nullptr;
+    textureStats.resident--;
+    textureStats.residentBytes -= entry.bytes;
+}
+
+void Graphics::TrimTextures() {
+    while (textureStats.residentBytes > textureBudget) {
+        // Only file textures can be brought back, and anything drawn this
+        // frame may still be referenced by queued geometry
+        TextureEntry* oldest = nullptr;
+        for (auto& entry : textures) {
+            if (entry.texture && !entry.path.empty() && entry.lastUsedFrame < frame &&
+                (!oldest || entry.lastUsedFrame < oldest->lastUsedFrame)) {
+                oldest = &entry;
+            }
+        }
+        if (!oldest) {
+            return;
+        }
+        DestroyEntryTexture(*oldest);
+        textureStats.evictions++;
+    }
+}
+
+TextureHandle Graphics::LoadTexture(const std::string& path) {
+    // Check if texture is already loaded
+    auto it = handlesByPath.find(path);
+    if (it != handlesByPath.end()) {
+        return it->second;
+    }
+    
+    TextureHandle handle = AllocateHandle();
+    TextureEntry& entry = textures[handle - 1];
+    entry.path = path;
+    entry.inUse = true;
+    textureStats.textures++;
+    
+    if (!LoadEntry(entry)) {
+        ReleaseTexture(handle);
+        return InvalidTexture;
+    }
+    
+    handlesByPath[path] = handle;
+    return handle;
+}
+
+TextureHandle Graphics::CreateTexture(int width, int height, SDL_TextureAccess access,
+                                      SDL_PixelFormat format) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, format, access, width, height);
+    if (!texture) {
+        LOG_ERROR(Render, "Unable to create %dx%d texture! SDL Error: %s", width, height, SDL_GetError());
+        return InvalidTexture;
+    }
+    
+    TextureHandle handle = AllocateHandle();
+    TextureEntry& entry = textures[handle - 1];
+    entry.texture = texture;
+    entry.bytes = (size_t)width * height * 4;
+    entry.lastUsedFrame = frame;
+    entry.inUse = true;
+    
+    textureStats.textures++;
+    textureStats.resident++;
+    textureStats.residentBytes += entry.bytes;
+    textureStats.loads++;
+    
+    TrimTextures();
+    return handle;
+}
+
+void Graphics::ReleaseTexture(TextureHandle handle) {
+    TextureEntry* entry = FindEntry(handle);
+    if (!entry) {
+        return;
+    }
+    
+    // Anything queued may still point at the texture
+    Flush();
+    DestroyEntryTexture(*entry);
+    if (!entry->path.empty()) {
+        handlesByPath.erase(entry->path);
+    }
+    *entry = TextureEntry();
+    freeHandles.push_back(handle);
+    textureStats.textures--;
+}
+
+SDL_Texture* Graphics::GetTexture(TextureHandle handle) {
+    TextureEntry* entry = FindEntry(handle);
+    if (!entry) {
         return nullptr;
     }
     
-    // Cache and return the texture
-    textureCache[path] = texture;
-    return texture;
+    entry->lastUsedFrame = frame;
+    if (!entry->texture && !entry->path.empty()) {
+        // Evicted earlier; bring it back
+        LoadEntry(*entry);
+    }
+    return entry->texture;
+}
+
+void Graphics::SetTextureBudget(size_t bytes) {
+    textureBudget = bytes;
+    TrimTextures();
 }
 
 void Graphics::DrawTexture(SDL_Texture* texture, const SDL_FRect& destRect, 
@@ -69,5 +292,17 @@ void Graphics::DrawTexture(SDL_Texture* texture, const SDL_FRect& destRect,
                           const SDL_FPoint* center, SDL_FlipMode flip) {
     if (!texture) return;
     
+    // Keep painter's order with the queued primitives
+    Flush();
     SDL_RenderTextureRotated(renderer, texture, srcRect, &destRect, angle, center, flip);
+    CountDrawCall(texture);
+}
+
+void Graphics::DrawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount,
+                            const int* indices, int indexCount) {
+    if (indexCount == 0) return;
+    
+    Flush();
+    SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices, indexCount);
+    CountDrawCall(texture);
 }
@@ -0,0 +1,107 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::Run(Batch& batch, int count, int grain) {
+    // A few jobs per thread so that stealing can even out uneven ranges
+    const int threads = ThreadCount();
+    int jobCount = std::min((count + grain - 1) / grain, threads * 4);
+    int jobSize = (count + jobCount - 1) / jobCount;
+    jobCount = (count + jobSize - 1) / jobSize;
+    batch.remaining.store(jobCount, std::memory_order_relaxed);
+
+    for (int j = 0; j < jobCount; j++) {
+        Job job{&batch, j * jobSize, std::min(count, (j + 1) * jobSize)};
+        WorkQueue& queue = *queues[j % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        submitted++;
+    }
+    wake.notify_all();
+
+    // Help until every job of this batch has finished, including ones
+    // another thread is still running
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        if (!RunOne(0)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int index) {
+    unsigned long long seen = 0;
+    for (;;) {
+        while (RunOne(index)) {
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [&] { return stopping || submitted != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = submitted;
+    }
+}
+
+bool JobSystem::RunOne(int index) {
+    Job job;
+    if (!Pop(index, job) && !Steal(index, job)) {
+        return false;
+    }
+
+    job.batch->run(job.batch->body, job.begin, job.end);
+    job.batch->remaining.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::Pop(int index, Job& job) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(int thief, Job& job) {
+    const int threads = ThreadCount();
+    for (int offset = 1; offset < threads; offset++) {
+        WorkQueue& queue = *queues[(thief + offset) % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,192 @@
+#include "Log.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct LogRecord {
+    uint64_t timeNS;
+    LogLevel level;
+    LogCategory category;
+    uint16_t length;
+    char text[maxLogMessageLength + 1];
+};
+
+// One producer (the owning thread), one consumer (the writer thread)
+struct LogRing {
+    static constexpr uint32_t capacity = 256;  // Power of two
+    LogRecord records[capacity];
+    std::atomic<uint32_t> head{0};  // Next record the owner fills
+    std::atomic<uint32_t> tail{0};  // Next record the writer takes
+};
+
+static const auto startTime = std::chrono::steady_clock::now();
+
+static std::atomic<int> minimumLevel{(int)LogLevel::Info};
+static std::atomic<uint64_t> dropped{0};
+static std::atomic<bool> running{false};
+
+// Rings live until exit, so the writer can still drain a thread that ended
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<LogRing>> rings;
+static thread_local LogRing* threadRing = nullptr;
+
+static std::mutex writerMutex;
+static std::condition_variable writerWake;
+static std::thread writer;
+static bool stopping = false;
+static FILE* output = nullptr;
+static uint64_t reportedDrops = 0;
+
+static const uint64_t flushIntervalMS = 10;
+
+static uint64_t NowNS() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+static void WriteLine(FILE* file, const LogRecord& record) {
+    std::fprintf(file, "[%10.3f] %-7s %-6s %.*s\n", record.timeNS / 1e9, GetLogLevelName(record.level),
+                 GetLogCategoryName(record.category), (int)record.length, record.text);
+}
+
+static LogRing* GetThreadRing() {
+    if (!threadRing) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(std::make_unique<LogRing>());
+        threadRing = rings.back().get();
+    }
+    return threadRing;
+}
+
+// Write out every queued record; only the writer thread, or StopLogging
+// once it has joined, may call this
+static void Drain() {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    for (auto& ring : rings) {
+        uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        const uint32_t head = ring->head.load(std::memory_order_acquire);
+        while (tail != head) {
+            WriteLine(output, ring->records[tail % LogRing::capacity]);
+            tail++;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    uint64_t drops = dropped.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+        std::fprintf(output, "[%10.3f] %-7s %-6s %llu messages dropped\n", NowNS() / 1e9,
+                     GetLogLevelName(LogLevel::Warning), GetLogCategoryName(LogCategory::General),
+                     (unsigned long long)(drops - reportedDrops));
+        reportedDrops = drops;
+    }
+    std::fflush(output);
+}
+
+static void WriterLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (!stopping) {
+        writerWake.wait_for(lock, std::chrono::milliseconds(flushIntervalMS));
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+const char* GetLogLevelName(LogLevel level) {
+    static const char* names[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+    return names[(int)level];
+}
+
+const char* GetLogCategoryName(LogCategory category) {
+    static const char* names[] = {"app", "game", "render", "assets", "replay", "files"};
+    return names[(int)category];
+}
+
+bool StartLogging(const char* path) {
+    if (running.load()) {
+        return true;
+    }
+
+    output = stderr;
+    if (path && path[0]) {
+        output = std::fopen(path, "a");
+        if (!output) {
+            output = stderr;
+            LOG_ERROR(General, "Unable to open log file %s", path);
+            return false;
+        }
+    }
+
+    stopping = false;
+    writer = std::thread(WriterLoop);
+    running.store(true);
+    return true;
+}
+
+void StopLogging() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopping = true;
+    }
+    writerWake.notify_one();
+    writer.join();
+
+    Drain();
+    if (output != stderr) {
+        std::fclose(output);
+    }
+    output = nullptr;
+}
+
+void SetLogLevel(LogLevel level) {
+    minimumLevel.store((int)level, std::memory_order_relaxed);
+}
+
+uint64_t GetDroppedLogCount() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void LogWrite(LogLevel level, LogCategory category, const char* format, ...) {
+    if ((int)level < minimumLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    LogRecord local;
+    LogRecord* record = &local;
+    LogRing* ring = nullptr;
+    uint32_t head = 0;
+    const bool async = running.load(std::memory_order_acquire);
+    if (async) {
+        ring = GetThreadRing();
+        head = ring->head.load(std::memory_order_relaxed);
+        if (head - ring->tail.load(std::memory_order_acquire) == LogRing::capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        record = &ring->records[head % LogRing::capacity];
+    }
+
+    record->timeNS = NowNS();
+    record->level = level;
+    record->category = category;
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(record->text, sizeof(record->text), format, args);
+    va_end(args);
+    record->length = (uint16_t)(length < 0 ? 0 : length > maxLogMessageLength ? maxLogMessageLength : length);
+
+    if (async) {
+        ring->head.store(head + 1, std::memory_order_release);
+    } else {
+        WriteLine(stderr, *record);
+    }
+}
@@ -0,0 +1,126 @@
+#include "MappedFile.h"
+#include "Log.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        LOG_ERROR(Files, "Unable to open %s", path.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        LOG_ERROR(Files, "Unable to read the size of %s", path.c_str());
+        Close();
+        return false;
+    }
+    size = (size_t)fileSize.QuadPart;
+    return Map(false);
+}
+
+bool MappedFile::Create(const std::string& path, size_t fileSize) {
+    Close();
+    file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        LOG_ERROR(Files, "Unable to create %s", path.c_str());
+        return false;
+    }
+    size = fileSize;
+    return Map(true);
+}
+
+bool MappedFile::Map(bool writable) {
+    // An empty file cannot be mapped, but is still a valid, empty view
+    if (size == 0) {
+        return true;
+    }
+    mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                 (DWORD)((unsigned long long)size >> 32), (DWORD)size, nullptr);
+    if (mapping) {
+        data = (uint8_t*)MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+    }
+    if (!data) {
+        LOG_ERROR(Files, "Unable to map file (error %lu)", (unsigned long)GetLastError());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+    if (file) CloseHandle(file);
+    data = nullptr;
+    mapping = nullptr;
+    file = nullptr;
+    size = 0;
+}
+#else
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        LOG_ERROR(Files, "Unable to open %s", path.c_str());
+        Close();
+        return false;
+    }
+    size = (size_t)info.st_size;
+    return Map(false);
+}
+
+bool MappedFile::Create(const std::string& path, size_t fileSize) {
+    Close();
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)fileSize) != 0) {
+        LOG_ERROR(Files, "Unable to create %s", path.c_str());
+        Close();
+        return false;
+    }
+    size = fileSize;
+    return Map(true);
+}
+
+bool MappedFile::Map(bool writable) {
+    // An empty file cannot be mapped, but is still a valid, empty view
+    if (size == 0) {
+        return true;
+    }
+    void* view = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Files, "Unable to map file");
+        Close();
+        return false;
+    }
+    data = (uint8_t*)view;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) munmap(data, size);
+    if (fd >= 0) close(fd);
+    data = nullptr;
+    fd = -1;
+    size = 0;
+}
+#endif
@@ -0,0 +1,158 @@
+#include "Random.h"
+#include "CpuFeatures.h"
+
+// Philox4x32 round multipliers and key increments (Salmon et al., 2011)
+static const Uint32 PHILOX_M0 = 0xD2511F53u;
+static const Uint32 PHILOX_M1 = 0xCD9E8D57u;
+static const Uint32 PHILOX_W0 = 0x9E3779B9u;
+static const Uint32 PHILOX_W1 = 0xBB67AE85u;
+static const int PHILOX_ROUNDS = 10;
+
+// Counter words are (counter lo, counter hi, stream lo, stream hi); the key
+// is the seed. Only the first output word is used.
+Uint32 RandomBits(Uint64 seed, Uint64 stream, Uint64 counter) {
+    Uint32 c0 = (Uint32)counter;
+    Uint32 c1 = (Uint32)(counter >> 32);
+    Uint32 c2 = (Uint32)stream;
+    Uint32 c3 = (Uint32)(stream >> 32);
+    Uint32 k0 = (Uint32)seed;
+    Uint32 k1 = (Uint32)(seed >> 32);
+
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        Uint64 p0 = (Uint64)PHILOX_M0 * c0;
+        Uint64 p1 = (Uint64)PHILOX_M1 * c2;
+        Uint32 n0 = (Uint32)(p1 >> 32) ^ c1 ^ k0;
+        Uint32 n2 = (Uint32)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (Uint32)p1;
+        c3 = (Uint32)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return c0;
+}
+
+// Top 24 bits, exactly representable as a float
+static inline float BitsToFloat(Uint32 bits) {
+    return (float)(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+float RandomFloat(Uint64 seed, Uint64 stream, Uint64 counter) {
+    return BitsToFloat(RandomBits(seed, stream, counter));
+}
+
+float RandomRange(Uint64 seed, Uint64 stream, Uint64 counter, float min, float max) {
+    return min + (max - min) * RandomFloat(seed, stream, counter);
+}
+
+static void FillRandomFloatsScalar(Uint64 seed, const Uint64* streams, Uint64 counter, float* out, int count) {
+    for (int i = 0; i < count; i++) {
+        out[i] = RandomFloat(seed, streams[i], counter);
+    }
+}
+
+#ifdef INVADERS_HAVE_X86
+// Low and high halves of the 32x32 -> 64 bit products a * m in each lane.
+// _mm_mul_epu32 only multiplies the even lanes, so the odd lanes are shifted
+// down and multiplied separately.
+static inline void MulHiLo(__m128i a, __m128i m, __m128i& lo, __m128i& hi) {
+    const __m128i evenLanes = _mm_set_epi32(0, -1, 0, -1);
+    __m128i even = _mm_mul_epu32(a, m);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    lo = _mm_or_si128(_mm_and_si128(even, evenLanes), _mm_slli_epi64(odd, 32));
+    hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(evenLanes, odd));
+}
+
+// Split four 64-bit streams into their low and high words
+static inline void LoadStreams(const Uint64* streams, __m128i& lo, __m128i& hi) {
+    __m128i a = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)streams), _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i b = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(streams + 2)), _MM_SHUFFLE(3, 1, 2, 0));
+    lo = _mm_unpacklo_epi64(a, b);
+    hi = _mm_unpackhi_epi64(a, b);
+}
+
+static void FillRandomFloatsSSE2(Uint64 seed, const Uint64* streams, Uint64 counter, float* out, int count) {
+    const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0);
+    const __m128i m1 = _mm_set1_epi32((int)PHILOX_M1);
+    const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i c0 = _mm_set1_epi32((int)(Uint32)counter);
+        __m128i c1 = _mm_set1_epi32((int)(Uint32)(counter >> 32));
+        __m128i c2, c3;
+        LoadStreams(streams + i, c2, c3);
+        Uint32 k0 = (Uint32)seed;
+        Uint32 k1 = (Uint32)(seed >> 32);
+
+        for (int round = 0; round < PHILOX_ROUNDS; round++) {
+            __m128i lo0, hi0, lo1, hi1;
+            MulHiLo(c0, m0, lo0, hi0);
+            MulHiLo(c2, m1, lo1, hi1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32((int)k0));
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32((int)k1));
+            c1 = lo1;
+            c3 = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        // Shifted right by 8 the bits fit a signed int, so the conversion is exact
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(c0, 8)), scale));
+    }
+    FillRandomFloatsScalar(seed, streams + i, counter, out + i, count - i);
+}
+
+INVADERS_TARGET_AVX2
+static inline void MulHiLo(__m256i a, __m256i m, __m256i& lo, __m256i& hi) {
+    const __m256i evenLanes = _mm256_set_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_or_si256(_mm256_and_si256(even, evenLanes), _mm256_slli_epi64(odd, 32));
+    hi = _mm256_or_si256(_mm256_srli_epi64(even, 32), _mm256_andnot_si256(evenLanes, odd));
+}
+
+INVADERS_TARGET_AVX2
+static void FillRandomFloatsAVX2(Uint64 seed, const Uint64* streams, Uint64 counter, float* out, int count) {
+    const __m256i m0 = _mm256_set1_epi32((int)PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi32((int)PHILOX_M1);
+    const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i c0 = _mm256_set1_epi32((int)(Uint32)counter);
+        __m256i c1 = _mm256_set1_epi32((int)(Uint32)(counter >> 32));
+        __m128i lowLo, lowHi, highLo, highHi;
+        LoadStreams(streams + i, lowLo, lowHi);
+        LoadStreams(streams + i + 4, highLo, highHi);
+        __m256i c2 = _mm256_set_m128i(highLo, lowLo);
+        __m256i c3 = _mm256_set_m128i(highHi, lowHi);
+        Uint32 k0 = (Uint32)seed;
+        Uint32 k1 = (Uint32)(seed >> 32);
+
+        for (int round = 0; round < PHILOX_ROUNDS; round++) {
+            __m256i lo0, hi0, lo1, hi1;
+            MulHiLo(c0, m0, lo0, hi0);
+            MulHiLo(c2, m1, lo1, hi1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32((int)k0));
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32((int)k1));
+            c1 = lo1;
+            c3 = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(c0, 8)), scale));
+    }
+    FillRandomFloatsSSE2(seed, streams + i, counter, out + i, count - i);
+}
+#endif
+
+void FillRandomFloats(Uint64 seed, const Uint64* streams, Uint64 counter, float* out, int count) {
+    using FillFn = void (*)(Uint64, const Uint64*, Uint64, float*, int);
+#ifdef INVADERS_HAVE_X86
+    static const FillFn fill = CpuHasAVX2() ? FillRandomFloatsAVX2 : FillRandomFloatsSSE2;
+#else
+    static const FillFn fill = FillRandomFloatsScalar;
+#endif
+    fill(seed, streams, counter, out, count);
+}
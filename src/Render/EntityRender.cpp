@@ -0,0 +1,166 @@
+#include "EntityRender.h"
+#include "Player.h"
+#include "Enemies.h"
+#include "ProjectilePool.h"
+#include "UFO.h"
+#include "Graphics.h"
+
+// Entity drawing lives here rather than in src/Entity so that the simulation
+// library (invaders_core) never references Graphics.
+
+// Position to draw at, blended between the last two simulation ticks
+static SDL_FPoint Interpolate(const SpriteFrame& frame, float alpha) {
+    return SDL_FPoint{
+        frame.previous.x + (frame.current.x - frame.previous.x) * alpha,
+        frame.previous.y + (frame.current.y - frame.previous.y) * alpha
+    };
+}
+
+void DrawPlayer(Graphics& graphics, const SpriteFrame& player, float alpha) {
+    const float width = Player::width;
+    const float height = Player::height;
+    SDL_FPoint pos = Interpolate(player, alpha);
+
+    // Draw player ship as a simple rectangle
+    Color playerColor(0, 255, 0);  // Green
+    SDL_FRect playerRect = {
+        pos.x - width * 0.5f,
+        pos.y - height * 0.5f,
+        width,
+        height
+    };
+
+    graphics.DrawRect(playerRect, playerColor, true);
+
+    // Draw a triangle on top to make it look like a ship
+    float triangleHeight = height * 0.5f;
+    graphics.DrawLine(
+        pos.x, pos.y - height * 0.5f - triangleHeight,
+        pos.x - width * 0.5f, pos.y - height * 0.5f,
+        playerColor
+    );
+    graphics.DrawLine(
+        pos.x, pos.y - height * 0.5f - triangleHeight,
+        pos.x + width * 0.5f, pos.y - height * 0.5f,
+        playerColor
+    );
+}
+
+void DrawEnemies(Graphics& graphics, const std::vector<SDL_FPoint>& cells, const SpriteFrame& offset, float alpha) {
+    const float width = Enemies::width;
+    const float height = Enemies::height;
+    SDL_FPoint shift = Interpolate(offset, alpha);
+
+    // Draw enemies as rectangles with some detail to make them look like aliens
+    Color enemyColor(255, 0, 0);  // Red
+    Color eyeColor(255, 255, 255);  // White
+    float eyeSize = width * 0.2f;
+
+    for (const SDL_FPoint& cell : cells) {
+        SDL_FPoint pos = {cell.x + shift.x, cell.y + shift.y};
+        SDL_FRect enemyRect = {
+            pos.x - width * 0.5f,
+            pos.y - height * 0.5f,
+            width,
+            height
+        };
+
+        SDL_FRect leftEye = {
+            pos.x - width * 0.25f - eyeSize * 0.5f,
+            pos.y - height * 0.25f - eyeSize * 0.5f,
+            eyeSize,
+            eyeSize
+        };
+
+        SDL_FRect rightEye = {
+            pos.x + width * 0.25f - eyeSize * 0.5f,
+            pos.y - height * 0.25f - eyeSize * 0.5f,
+            eyeSize,
+            eyeSize
+        };
+
+        graphics.DrawRect(enemyRect, enemyColor, true);
+        graphics.DrawRect(leftEye, eyeColor, true);
+        graphics.DrawRect(rightEye, eyeColor, true);
+    }
+}
+
+void DrawProjectiles(Graphics& graphics, const std::vector<SpriteFrame>& projectiles, float alpha) {
+    const float width = ProjectilePool::width;
+    const float height = ProjectilePool::height;
+
+    // Draw bullets as small rectangles
+    Color bulletColor(255, 255, 0);  // Yellow
+
+    for (const SpriteFrame& projectile : projectiles) {
+        SDL_FPoint pos = Interpolate(projectile, alpha);
+        SDL_FRect bulletRect = {
+            pos.x - width * 0.5f,
+            pos.y - height * 0.5f,
+            width,
+            height
+        };
+
+        graphics.DrawRect(bulletRect, bulletColor, true);
+    }
+}
+
+bool UploadBarrier(SDL_Texture* texture, const Barrier::State& barrier, Barrier::State& uploaded,
+                   int& top, int& bottom) {
+    if (!texture) return false;
+
+    // Upload only the rows eroded since the last frame
+    top = 0;
+    while (top < Barrier::rows && barrier.cells[top] == uploaded.cells[top]) {
+        top++;
+    }
+    if (top == Barrier::rows) {
+        return false;
+    }
+    bottom = Barrier::rows - 1;
+    while (barrier.cells[bottom] == uploaded.cells[bottom]) {
+        bottom--;
+    }
+
+    const Uint32 barrierColor = 0x00C800FF;  // Dark green, RGBA8888
+    Uint32 pixels[Barrier::rows * Barrier::cols];
+
+    for (int row = top; row <= bottom; row++) {
+        for (int col = 0; col < Barrier::cols; col++) {
+            pixels[row * Barrier::cols + col] = (barrier.cells[row] >> col) & 1 ? barrierColor : 0;
+        }
+        uploaded.cells[row] = barrier.cells[row];
+    }
+
+    SDL_Rect dirty = {0, top, Barrier::cols, bottom - top + 1};
+    SDL_UpdateTexture(texture, &dirty, &pixels[top * Barrier::cols], Barrier::cols * sizeof(Uint32));
+    return true;
+}
+
+void DrawUFO(Graphics& graphics, const SpriteFrame& ufo, float alpha) {
+    const float width = UFO::width;
+    const float height = UFO::height;
+    SDL_FPoint pos = Interpolate(ufo, alpha);
+
+    // Draw UFO as an ellipse (approximated with a rectangle)
+    Color ufoColor(255, 0, 255);  // Purple
+    SDL_FRect ufoRect = {
+        pos.x - width * 0.5f,
+        pos.y - height * 0.5f,
+        width,
+        height
+    };
+
+    graphics.DrawRect(ufoRect, ufoColor, true);
+
+    // Draw a "cockpit" in the middle
+    Color cockpitColor(150, 150, 255);  // Light blue
+    SDL_FRect cockpitRect = {
+        pos.x - width * 0.2f,
+        pos.y - height * 0.25f,
+        width * 0.4f,
+        height * 0.5f
+    };
+
+    graphics.DrawRect(cockpitRect, cockpitColor, true);
+}
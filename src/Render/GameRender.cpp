@@ -0,0 +1,202 @@
+#include "Game.h"
+#include "Graphics.h"
+#include "TextRenderer.h"
+#include "Player.h"
+#include "UFO.h"
+#include "EntityRender.h"
+#include "PerfOverlay.h"
+#include "Hud.h"
+
+static const char* FONT_PATH = "assets/fonts/DejaVuSans.ttf";
+static const Color BACKGROUND_COLOR(0, 0, 30, 255);
+
+Game::Game(SDL_Window* window, SDL_Renderer* renderer, const GameConfig& config)
+    : config(config), window(window), renderer(renderer) {
+    // Draw in field coordinates, scaled to fit the window
+    SDL_SetRenderLogicalPresentation(renderer, (int)config.fieldWidth, (int)config.fieldHeight,
+                                     SDL_LOGICAL_PRESENTATION_LETTERBOX);
+    
+    // Create graphics shared by every entity
+    graphics = std::make_shared<Graphics>(renderer);
+    
+    // Create text renderer
+    textRenderer = std::make_shared<TextRenderer>(graphics.get());
+    
+    // Attempt to load a font (falls back to primitive rendering if not found)
+    textRenderer->LoadFont(FONT_PATH, 24);
+    
+    hud = std::make_shared<Hud>(textRenderer.get(), config.fieldWidth, config.fieldHeight);
+    
+    perfOverlay = std::make_shared<PerfOverlay>(graphics.get(), FONT_PATH);
+}
+
+// Repaint rows top..bottom of a barrier in the static layer, background
+// first so that eroded cells are cleared
+static void PaintBarrierRows(Graphics& graphics, SDL_Texture* texture, SDL_FPoint position, int top, int bottom) {
+    SDL_FRect bounds = Barrier::BoundsAt(position);
+    SDL_FRect strip = {
+        bounds.x,
+        bounds.y + top * Barrier::cellSize,
+        bounds.w,
+        (float)((bottom - top + 1) * Barrier::cellSize)
+    };
+    SDL_FRect source = {0.0f, (float)top, (float)Barrier::cols, (float)(bottom - top + 1)};
+    graphics.DrawRect(strip, BACKGROUND_COLOR, true);
+    graphics.DrawTexture(texture, strip, &source);
+}
+
+void Game::RenderStaticLayer(const RenderSnapshot& frame) {
+    if (staticLayer == InvalidTexture) {
+        staticLayer = graphics->CreateTexture((int)config.fieldWidth, (int)config.fieldHeight,
+                                              SDL_TEXTUREACCESS_TARGET);
+        if (SDL_Texture* texture = graphics->GetTexture(staticLayer)) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+        }
+        staticLayerValid = false;
+    }
+    
+    // One texture per barrier slot for the whole session. A new texture's
+    // uploaded cells are the complement of the barrier's, so every row goes
+    // up on its first upload.
+    while (barrierTextures.size() < frame.barriers.size()) {
+        TextureHandle handle = graphics->CreateTexture(Barrier::cols, Barrier::rows,
+                                                       SDL_TEXTUREACCESS_STREAMING);
+        if (SDL_Texture* texture = graphics->GetTexture(handle)) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        }
+        barrierTextures.push_back(handle);
+        Barrier::State uploaded = frame.barriers[uploadedBarriers.size()];
+        for (uint64_t& row : uploaded.cells) {
+            row = ~row;
+        }
+        uploadedBarriers.push_back(uploaded);
+    }
+    
+    // Barriers never move, but a different set of them repaints everything
+    if (frame.barriers.size() != layerBarriers) {
+        staticLayerValid = false;
+    }
+    for (size_t slot = 0; slot < frame.barriers.size(); slot++) {
+        const SDL_FPoint& position = frame.barriers[slot].position;
+        if (position.x != uploadedBarriers[slot].position.x || position.y != uploadedBarriers[slot].position.y) {
+            uploadedBarriers[slot].position = position;
+            staticLayerValid = false;
+        }
+    }
+    
+    SDL_Texture* layer = graphics->GetTexture(staticLayer);
+    bool painting = false;
+    for (size_t slot = 0; slot < frame.barriers.size(); slot++) {
+        SDL_Texture* texture = graphics->GetTexture(barrierTextures[slot]);
+        int top, bottom;
+        if (!UploadBarrier(texture, frame.barriers[slot], uploadedBarriers[slot], top, bottom) ||
+            !layer || !staticLayerValid) {
+            continue;
+        }
+        if (!painting) {
+            graphics->SetRenderTarget(layer);
+            painting = true;
+        }
+        PaintBarrierRows(*graphics, texture, frame.barriers[slot].position, top, bottom);
+    }
+    
+    if (!layer) {
+        // No render target: draw the barriers straight to the window
+        for (size_t slot = 0; slot < frame.barriers.size(); slot++) {
+            graphics->DrawTexture(graphics->GetTexture(barrierTextures[slot]),
+                                  Barrier::BoundsAt(frame.barriers[slot].position));
+        }
+        return;
+    }
+    
+    if (!staticLayerValid) {
+        if (!painting) {
+            graphics->SetRenderTarget(layer);
+            painting = true;
+        }
+        graphics->Clear(BACKGROUND_COLOR);
+        for (size_t slot = 0; slot < frame.barriers.size(); slot++) {
+            graphics->DrawTexture(graphics->GetTexture(barrierTextures[slot]),
+                                  Barrier::BoundsAt(frame.barriers[slot].position));
+        }
+        layerBarriers = frame.barriers.size();
+        staticLayerValid = true;
+    }
+    if (painting) {
+        graphics->SetRenderTarget(nullptr);
+    }
+    
+    graphics->DrawTexture(layer, SDL_FRect{0.0f, 0.0f, config.fieldWidth, config.fieldHeight});
+}
+
+void Game::RenderPerfOverlay(const RenderSnapshot& frame) {
+    PerfCounts counts;
+    counts.enemies = (int)frame.enemies.size();
+    counts.bullets = (int)frame.projectiles.size();
+    counts.bricks = frame.bricks;
+    counts.drawCalls = graphics->GetLastFrameStats().drawCalls;
+    counts.textures = graphics->GetTextureStats().textures;
+    
+    perfOverlay->Render(profiler, counts);
+}
+
+void Game::Render(float alpha) {
+    CaptureRenderSnapshot(renderFrame);
+    Draw(renderFrame, alpha);
+}
+
+void Game::Draw(const RenderSnapshot& frame, float alpha) {
+    // The simulation's time is counted once per snapshot, however many
+    // frames draw it
+    if (frame.sequence != drawnSequence) {
+        drawnSequence = frame.sequence;
+        profiler.Add(FramePhase::Update, frame.simulation.phaseNS[(int)FramePhase::Update]);
+        profiler.Add(FramePhase::Collisions, frame.simulation.phaseNS[(int)FramePhase::Collisions]);
+    }
+    
+    PROFILE_PHASE(profiler, FramePhase::Render);
+    
+    // Clear screen, which also fills any letterbox bars
+    graphics->Clear(BACKGROUND_COLOR);
+    
+    // Background and barriers from the cached layer, first so that its
+    // texture draw does not split the primitive batch
+    RenderStaticLayer(frame);
+    
+    // Render player
+    if (frame.playerVisible) {
+        DrawPlayer(*graphics, frame.player, alpha);
+    }
+    
+    // Render enemies
+    DrawEnemies(*graphics, frame.enemies, frame.formationOffset, alpha);
+    
+    // Render bullets
+    DrawProjectiles(*graphics, frame.projectiles, alpha);
+    
+    // Render UFO
+    if (frame.ufoVisible) {
+        DrawUFO(*graphics, frame.ufo, alpha);
+    }
+    
+    // Render score
+    hud->RenderScore(frame);
+    
+    // Render game over message if needed
+    if (frame.gameOver) {
+        // Game over overlay
+        SDL_FRect overlay = {0, 0, config.fieldWidth, config.fieldHeight};
+        graphics->DrawRect(overlay, Color(50, 0, 0, 180), true);
+        
+        hud->RenderGameOver(frame);
+    }
+    
+    if (frame.showPerfOverlay) {
+        RenderPerfOverlay(frame);
+    }
+    
+    // Present the rendered frame
+    PROFILE_PHASE(profiler, FramePhase::Present);
+    graphics->Present();
+}
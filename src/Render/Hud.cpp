@@ -0,0 +1,65 @@
+#include "Hud.h"
+#include "RenderSnapshot.h"
+#include <charconv>
+
+static const Color HUD_COLOR(255, 255, 255);
+
+HudLabel::HudLabel(const char* format, float x, float y, const Color& color)
+    : format(format), x(x), y(y), color(color) {
+}
+
+void HudLabel::Format() {
+    char* out = buffer;
+    char* end = buffer + capacity;
+    int next = 0;
+    for (const char* c = format; *c && out < end; c++) {
+        if (c[0] == '{' && c[1] == '}' && next < maxValues) {
+            // A value that does not fit leaves out pointing at end
+            out = std::to_chars(out, end, values[next++]).ptr;
+            c++;
+        } else {
+            *out++ = *c;
+        }
+    }
+    length = (int)(out - buffer);
+    formatted = true;
+    laidOut = false;
+}
+
+void HudLabel::Draw(TextRenderer& text) {
+    if (!formatted) {
+        Format();
+    }
+    // The quads point into the glyph atlas, so lay out again if it was emptied
+    if (!laidOut || !text.IsCurrent(layout)) {
+        laidOut = text.Layout(GetText(), x, y, color, true, layout);
+    }
+    if (laidOut) {
+        text.DrawLayout(layout);
+    } else {
+        text.DrawText(GetText(), x, y, color, true);
+    }
+}
+
+Hud::Hud(TextRenderer* text, float fieldWidth, float fieldHeight)
+    : text(text),
+      scoreLine("SCORE: {}   HIGH SCORE: {}   LEVEL: {}   LIVES: {}", fieldWidth * 0.5f, 20.0f, HUD_COLOR),
+      gameOver("GAME OVER", fieldWidth * 0.5f, fieldHeight * 0.5f - 50.0f, HUD_COLOR),
+      restartHint("PRESS R TO RESTART", fieldWidth * 0.5f, fieldHeight * 0.5f, HUD_COLOR),
+      finalScore("FINAL SCORE: {}", fieldWidth * 0.5f, fieldHeight * 0.5f + 50.0f, HUD_COLOR) {
+}
+
+void Hud::RenderScore(const RenderSnapshot& frame) {
+    scoreLine.Set(0, frame.score);
+    scoreLine.Set(1, frame.highScore);
+    scoreLine.Set(2, frame.level);
+    scoreLine.Set(3, frame.lives);
+    scoreLine.Draw(*text);
+}
+
+void Hud::RenderGameOver(const RenderSnapshot& frame) {
+    gameOver.Draw(*text);
+    restartHint.Draw(*text);
+    finalScore.Set(0, frame.score);
+    finalScore.Draw(*text);
+}
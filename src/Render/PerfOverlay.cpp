@@ -0,0 +1,153 @@
+#include "PerfOverlay.h"
+#include "Graphics.h"
+#include "TextRenderer.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+static const Color phaseColors[framePhaseCount] = {
+    Color(120, 120, 255),  // Events
+    Color(0, 200, 0),      // Update
+    Color(255, 160, 0),    // Collisions
+    Color(0, 200, 255),    // Render
+    Color(255, 60, 60),    // Present
+};
+static const Color idleColor(70, 70, 70);  // Frame time outside every phase, mostly sleeping
+static const Color textColor(255, 255, 255);
+
+static const float panelX = 10.0f;
+static const float panelY = 45.0f;
+static const float padding = 6.0f;
+static const float lineHeight = 16.0f;
+static const float swatchSize = 10.0f;
+static const float graphHeight = 64.0f;
+// The graph is two 60 Hz frames tall, with a marker at one frame
+static const float graphSpanMS = 2000.0f / 60.0f;
+static const float budgetMS = 1000.0f / 60.0f;
+
+static std::string FormatMS(double ns) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << ns / 1e6;
+    return ss.str();
+}
+
+PerfOverlay::PerfOverlay(Graphics* graphics, const std::string& fontPath)
+    : graphics(graphics) {
+    text = std::make_unique<TextRenderer>(graphics, TextRenderer::defaultAtlasBudget / 4);
+    text->LoadFont(fontPath, 14);
+}
+
+PerfOverlay::~PerfOverlay() {
+}
+
+void PerfOverlay::DrawLine(const std::string& line, float x, float y) {
+    text->DrawText(line, x, y, textColor, false);
+}
+
+void PerfOverlay::Render(const FrameProfiler& profiler, const PerfCounts& counts) {
+    const int frames = profiler.FrameCount();
+
+    // Average and worst case of each phase over the graph window
+    double frameSum = 0.0;
+    double phaseSum[framePhaseCount] = {};
+    Uint64 phasePeak[framePhaseCount] = {};
+    for (int age = 0; age < frames; age++) {
+        const FrameTiming& frame = profiler.GetFrame(age);
+        frameSum += (double)frame.frameNS;
+        for (int phase = 0; phase < framePhaseCount; phase++) {
+            phaseSum[phase] += (double)frame.phaseNS[phase];
+            phasePeak[phase] = std::max(phasePeak[phase], frame.phaseNS[phase]);
+        }
+    }
+
+#ifdef INVADERS_PROFILING
+    const int phaseLines = framePhaseCount;
+#else
+    const int phaseLines = 1;
+#endif
+    const int lineCount = 1 + phaseLines + 3;
+    const float width = FrameProfiler::historySize + padding * 2.0f;
+    const float height = padding * 3.0f + lineCount * lineHeight + graphHeight;
+    graphics->DrawRect(SDL_FRect{panelX, panelY, width, height}, Color(0, 0, 0, 170), true);
+
+    const float textX = panelX + padding;
+    float y = panelY + padding;
+
+    // Frame time of the latest frame, FPS averaged over the window
+    {
+        std::ostringstream ss;
+        ss << "FRAME " << (frames > 0 ? FormatMS((double)profiler.GetFrame(0).frameNS) : "-")
+           << " MS   " << std::fixed << std::setprecision(1)
+           << (frameSum > 0.0 ? frames * 1e9 / frameSum : 0.0) << " FPS";
+        DrawLine(ss.str(), textX, y);
+        y += lineHeight;
+    }
+
+#ifdef INVADERS_PROFILING
+    for (int phase = 0; phase < framePhaseCount; phase++) {
+        graphics->DrawRect(SDL_FRect{textX, y + (lineHeight - swatchSize) * 0.5f, swatchSize, swatchSize},
+                           phaseColors[phase], true);
+
+        std::ostringstream ss;
+        ss << GetFramePhaseName((FramePhase)phase) << " "
+           << FormatMS(frames > 0 ? phaseSum[phase] / frames : 0.0) << " AVG  "
+           << FormatMS((double)phasePeak[phase]) << " MAX";
+        DrawLine(ss.str(), textX + swatchSize + 6.0f, y);
+        y += lineHeight;
+    }
+#else
+    DrawLine("PHASE TIMING COMPILED OUT", textX, y);
+    y += lineHeight;
+#endif
+
+    {
+        std::ostringstream ss;
+        ss << "ENEMIES " << counts.enemies << "   BULLETS " << counts.bullets;
+        DrawLine(ss.str(), textX, y);
+        y += lineHeight;
+    }
+    {
+        std::ostringstream ss;
+        ss << "BRICKS " << counts.bricks << "   DRAW CALLS " << counts.drawCalls;
+        DrawLine(ss.str(), textX, y);
+        y += lineHeight;
+    }
+    {
+        std::ostringstream ss;
+        ss << "TEXTURES " << counts.textures;
+        DrawLine(ss.str(), textX, y);
+        y += lineHeight;
+    }
+
+    // Stacked graph, oldest frame on the left. Each column is the frame's
+    // phases bottom up, topped with the rest of the frame time in grey.
+    const float graphX = panelX + padding;
+    const float graphBottom = y + padding + graphHeight;
+    const float pixelsPerNS = graphHeight / (graphSpanMS * 1e6f);
+
+    for (int age = 0; age < frames; age++) {
+        const FrameTiming& frame = profiler.GetFrame(age);
+        float x = graphX + FrameProfiler::historySize - 1 - age;
+        float top = graphBottom;
+        Uint64 accounted = 0;
+
+        for (int phase = 0; phase < framePhaseCount && top > graphBottom - graphHeight; phase++) {
+            float h = std::min(frame.phaseNS[phase] * pixelsPerNS, top - (graphBottom - graphHeight));
+            if (h > 0.0f) {
+                top -= h;
+                graphics->DrawRect(SDL_FRect{x, top, 1.0f, h}, phaseColors[phase], true);
+            }
+            accounted += frame.phaseNS[phase];
+        }
+
+        if (frame.frameNS > accounted) {
+            float h = std::min((frame.frameNS - accounted) * pixelsPerNS, top - (graphBottom - graphHeight));
+            if (h > 0.0f) {
+                graphics->DrawRect(SDL_FRect{x, top - h, 1.0f, h}, idleColor, true);
+            }
+        }
+    }
+
+    float budgetY = graphBottom - budgetMS / graphSpanMS * graphHeight;
+    graphics->DrawLine(graphX, budgetY, graphX + FrameProfiler::historySize, budgetY, Color(255, 255, 255, 120));
+}
@@ -0,0 +1,58 @@
+#include "Game.h"
+#include "Player.h"
+#include "Barrier.h"
+#include "UFO.h"
+
+// Capturing is part of the simulation library: it only reads game state, and
+// the thread that runs Update is the one that calls it.
+
+void Game::CaptureRenderSnapshot(RenderSnapshot& frame) {
+    frame.sequence = ++capturedFrames;
+    frame.tick = tick;
+    frame.tickDueNS = 0;
+
+    frame.playerVisible = player && !player->IsDestroyed();
+    if (player) {
+        Player::State state = player->GetState();
+        frame.player = SpriteFrame{state.previousPosition, state.position};
+        frame.lives = state.lives;
+    }
+
+    frame.ufoVisible = ufo && ufo->IsActive() && !ufo->IsDestroyed();
+    if (ufo) {
+        UFO::State state = ufo->GetState();
+        frame.ufo = SpriteFrame{state.previousPosition, state.position};
+    }
+
+    const Formation& formation = enemies.GetFormation();
+    frame.formationOffset = SpriteFrame{formation.GetOffset(0.0f), formation.GetOffset()};
+    const FormationCell* cell = enemies.GetStore().Data<FormationCell>();
+    frame.enemies.clear();
+    for (int i = 0; i < enemies.Count(); i++) {
+        if (enemies.IsAlive(i)) {
+            frame.enemies.push_back(formation.GetCellPosition(cell[i].column, cell[i].row));
+        }
+    }
+
+    frame.projectiles.clear();
+    for (int i = 0; i < projectiles.Count(); i++) {
+        if (projectiles.IsAlive(i)) {
+            frame.projectiles.push_back(SpriteFrame{projectiles.GetPreviousPosition(i), projectiles.GetPosition(i)});
+        }
+    }
+
+    frame.barriers.clear();
+    frame.bricks = 0;
+    for (const auto& barrier : barriers) {
+        frame.barriers.push_back(barrier->GetState());
+        frame.bricks += barrier->CountIntactCells();
+    }
+
+    frame.score = score;
+    frame.highScore = highScore;
+    frame.level = level;
+    frame.gameOver = gameOver;
+    frame.showPerfOverlay = showPerfOverlay;
+
+    frame.simulation = simulationProfiler.TakeCurrent();
+}
@@ -0,0 +1,238 @@
+#include "Replay.h"
+#include "BinaryStream.h"
+#include "Game.h"
+#include "Log.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+static const uint32_t REPLAY_MAGIC = 0x52564E49;  // "INVR"
+// Keyframes embed Game snapshots, so this goes up whenever their version does
+static const uint32_t REPLAY_VERSION = 5;
+
+ReplayRecorder::ReplayRecorder(const GameConfig& config, int tickRate, int keyframeInterval)
+    : keyframeInterval(keyframeInterval) {
+    ReplayHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.tickRate = (uint32_t)tickRate;
+    header.keyframeInterval = (uint32_t)keyframeInterval;
+    header.configSize = sizeof(GameConfig);
+    header.config = config;
+
+    BinaryWriter writer(data);
+    writer.Write(header);
+}
+
+void ReplayRecorder::BeginRecord(Uint64 tick, ReplayRecord kind) {
+    BinaryWriter writer(data);
+    writer.WriteVarint(tick - lastTick);
+    writer.Write(kind);
+    lastTick = tick;
+}
+
+void ReplayRecorder::RecordEvent(Uint64 tick, const SDL_Event& event) {
+    if (event.type != SDL_EVENT_KEY_DOWN && event.type != SDL_EVENT_KEY_UP) {
+        return;
+    }
+
+    BeginRecord(tick, ReplayRecord::Event);
+    uint8_t flags = (event.type == SDL_EVENT_KEY_DOWN ? ReplayKeyDown : 0) |
+                    (event.key.repeat ? ReplayKeyRepeat : 0);
+    BinaryWriter writer(data);
+    writer.Write(flags);
+    writer.WriteVarint((uint64_t)event.key.scancode);
+}
+
+void ReplayRecorder::RecordRestart(Uint64 tick) {
+    BeginRecord(tick, ReplayRecord::Restart);
+}
+
+void ReplayRecorder::BeginTick(const Game& game) {
+    Uint64 tick = game.GetTick();
+    if (keyframeInterval <= 0 || tick % keyframeInterval != 0) {
+        return;
+    }
+
+    game.SaveSnapshot(snapshot);
+    BeginRecord(tick, ReplayRecord::Keyframe);
+    BinaryWriter writer(data);
+    writer.WriteVarint(snapshot.size());
+    writer.WriteBytes(snapshot.data(), snapshot.size());
+}
+
+bool ReplayRecorder::Save(const std::string& path, Uint64 endTick) {
+    std::vector<uint8_t> file = data;
+    Uint64 tick = endTick > lastTick ? endTick : lastTick;
+    BinaryWriter writer(file);
+    writer.WriteVarint(tick - lastTick);
+    writer.Write(ReplayRecord::End);
+
+    std::ofstream out(path, std::ios::binary);
+    out.write((const char*)file.data(), (std::streamsize)file.size());
+    if (!out) {
+        LOG_ERROR(Replay, "Unable to write replay %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReplayPlayer::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        LOG_ERROR(Replay, "Unable to open replay %s", path.c_str());
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    BinaryReader reader(data.data(), data.size());
+    if (!reader.Read(header) || header.magic != REPLAY_MAGIC) {
+        LOG_ERROR(Replay, "%s is not a replay", path.c_str());
+        return false;
+    }
+    if (header.version != REPLAY_VERSION || header.configSize != sizeof(GameConfig) || header.tickRate == 0) {
+        LOG_ERROR(Replay, "%s was recorded by an incompatible build (version %u)", path.c_str(),
+                  (unsigned)header.version);
+        return false;
+    }
+
+    // Walk every record once so playback never meets a malformed one
+    Record record{};
+    size_t at = reader.Offset();
+    Uint64 tick = 0;
+    while (ParseRecord(at, tick, record)) {
+        at = record.next;
+        tick = record.tick;
+        if (record.kind == ReplayRecord::End) {
+            break;
+        }
+    }
+    if (record.kind != ReplayRecord::End) {
+        LOG_ERROR(Replay, "%s is truncated or corrupt", path.c_str());
+        return false;
+    }
+
+    endTick = tick;
+    offset = sizeof(ReplayHeader);
+    cursorTick = 0;
+    desynced = false;
+    return true;
+}
+
+bool ReplayPlayer::ParseRecord(size_t at, Uint64 previousTick, Record& record) const {
+    if (at >= data.size()) {
+        return false;
+    }
+
+    BinaryReader reader(data.data() + at, data.size() - at);
+    uint64_t delta;
+    if (!reader.ReadVarint(delta) || !reader.Read(record.kind)) {
+        return false;
+    }
+    record.tick = previousTick + delta;
+
+    switch (record.kind) {
+        case ReplayRecord::Event:
+            if (!reader.Read(record.flags) || !reader.ReadVarint(record.scancode)) {
+                return false;
+            }
+            break;
+        case ReplayRecord::Keyframe: {
+            uint64_t size;
+            if (!reader.ReadVarint(size) || size > data.size()) {
+                return false;
+            }
+            record.snapshot = reader.Skip((size_t)size);
+            record.snapshotSize = (size_t)size;
+            if (!record.snapshot) {
+                return false;
+            }
+            break;
+        }
+        case ReplayRecord::Restart:
+        case ReplayRecord::End:
+            break;
+        default:
+            return false;
+    }
+
+    record.next = at + reader.Offset();
+    return true;
+}
+
+void ReplayPlayer::Feed(Game& game) {
+    Record record;
+    while (ParseRecord(offset, cursorTick, record) && record.tick <= game.GetTick() &&
+           record.kind != ReplayRecord::End) {
+        offset = record.next;
+        cursorTick = record.tick;
+
+        switch (record.kind) {
+            case ReplayRecord::Event: {
+                SDL_Event event{};
+                bool down = (record.flags & ReplayKeyDown) != 0;
+                event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+                event.key.scancode = (SDL_Scancode)record.scancode;
+                event.key.down = down;
+                event.key.repeat = (record.flags & ReplayKeyRepeat) != 0;
+                game.HandleEvent(event);
+                break;
+            }
+            case ReplayRecord::Restart:
+                game.Restart();
+                break;
+            case ReplayRecord::Keyframe:
+                // The recording and the playback must agree byte for byte
+                if (!desynced) {
+                    game.SaveSnapshot(snapshot);
+                    if (snapshot.size() != record.snapshotSize ||
+                        std::memcmp(snapshot.data(), record.snapshot, record.snapshotSize) != 0) {
+                        desynced = true;
+                        desyncTick = record.tick;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool ReplayPlayer::IsFinished(const Game& game) const {
+    return game.GetTick() >= endTick;
+}
+
+bool ReplayPlayer::Seek(Game& game, Uint64 tick) {
+    // Find the last keyframe at or before tick
+    Record record;
+    Record keyframe;
+    bool found = false;
+    size_t at = sizeof(ReplayHeader);
+    Uint64 previous = 0;
+    while (ParseRecord(at, previous, record) && record.tick <= tick && record.kind != ReplayRecord::End) {
+        if (record.kind == ReplayRecord::Keyframe) {
+            keyframe = record;
+            found = true;
+        }
+        at = record.next;
+        previous = record.tick;
+    }
+
+    if (found) {
+        if (!game.LoadSnapshot(keyframe.snapshot, keyframe.snapshotSize)) {
+            LOG_ERROR(Replay, "Replay keyframe at tick %llu could not be restored", (unsigned long long)keyframe.tick);
+            return false;
+        }
+        // Continue with the records after the keyframe
+        offset = keyframe.next;
+        cursorTick = keyframe.tick;
+    }
+
+    const float tickSeconds = 1.0f / header.tickRate;
+    while (game.GetTick() < tick && !IsFinished(game)) {
+        Feed(game);
+        game.Update(tickSeconds);
+    }
+    return true;
+}
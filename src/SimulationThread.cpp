@@ -0,0 +1,100 @@
+#include "SimulationThread.h"
+#include "Game.h"
+#include <algorithm>
+
+SimulationThread::SimulationThread(Game& game, int tickRate, int maxCatchUpSteps)
+    : game(game), tickSeconds(1.0f / tickRate), tickNS(SDL_NS_PER_SECOND / tickRate),
+      maxCatchUpSteps(maxCatchUpSteps) {
+}
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start() {
+    Publish(SDL_GetTicksNS());
+    thread = std::thread(&SimulationThread::Run, this);
+}
+
+void SimulationThread::Stop() {
+    stopping.store(true, std::memory_order_release);
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void SimulationThread::PostEvent(const SDL_Event& event) {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    pendingEvents.push_back(event);
+}
+
+const RenderSnapshot& SimulationThread::AcquireFrame() {
+    frames.Acquire();
+    return frames.Front();
+}
+
+float SimulationThread::GetAlpha(const RenderSnapshot& frame, Uint64 now) const {
+    if (frame.tickDueNS == 0) {
+        return 1.0f;
+    }
+    if (now <= frame.tickDueNS) {
+        return 0.0f;
+    }
+    return std::min(1.0f, (float)(now - frame.tickDueNS) / (float)tickNS);
+}
+
+void SimulationThread::Publish(Uint64 tickDueNS) {
+    RenderSnapshot& frame = frames.Back();
+    game.CaptureRenderSnapshot(frame);
+    frame.tickDueNS = tickDueNS;
+    frames.Publish();
+}
+
+void SimulationThread::Run() {
+    Uint64 lastTime = SDL_GetTicksNS();
+    Uint64 accumulator = 0;
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(eventMutex);
+            handledEvents.swap(pendingEvents);
+        }
+        for (const SDL_Event& event : handledEvents) {
+            game.HandleEvent(event);
+        }
+        handledEvents.clear();
+
+        // Accumulate elapsed wall time
+        Uint64 currentTime = SDL_GetTicksNS();
+        accumulator += currentTime - lastTime;
+        lastTime = currentTime;
+
+        // Run every tick that is due, up to the catch-up limit
+        int steps = 0;
+        while (accumulator >= tickNS && steps < maxCatchUpSteps) {
+            if (beforeTick && !beforeTick(game)) {
+                finished.store(true, std::memory_order_release);
+                return;
+            }
+            game.Update(tickSeconds);
+            accumulator -= tickNS;
+            steps++;
+            if (afterTick && !afterTick(game)) {
+                finished.store(true, std::memory_order_release);
+                return;
+            }
+        }
+
+        // After a long stall, drop the backlog rather than spiralling
+        if (accumulator >= tickNS) {
+            accumulator %= tickNS;
+        }
+
+        if (steps > 0) {
+            Publish(currentTime - accumulator);
+        }
+
+        // Sleep until the next tick is due
+        SDL_DelayNS(tickNS - accumulator);
+    }
+}
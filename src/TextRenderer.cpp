@@ -1,24 +1,24 @@
 #include "TextRenderer.h"
-#include <iostream>
+#include "Log.h"
+#include <algorithm>
 
-TextRenderer::TextRenderer(Graphics* graphics, SDL_Renderer* renderer) 
-    : graphics(graphics), renderer(renderer) {
+TextRenderer::TextRenderer(Graphics* graphics, int atlasBudgetBytes) 
+    : graphics(graphics), atlasBudget(atlasBudgetBytes) {
     
 #ifndef NO_SDL_TTF
     // Initialize SDL_ttf
-    if (TTF_Init() != 0) {
-        std::cerr << "Failed to initialize SDL_ttf: " << TTF_GetError() << std::endl;
+    if (!TTF_Init()) {
+        LOG_ERROR(Assets, "Failed to initialize SDL_ttf: %s", SDL_GetError());
     }
 #endif
 }
 
 TextRenderer::~TextRenderer() {
 #ifndef NO_SDL_TTF
-    // Free cached textures
-    for (auto& [key, texture] : textCache) {
-        SDL_DestroyTexture(texture);
-    }
-    textCache.clear();
+    // Free the glyph atlas
+    graphics->ReleaseTexture(atlasHandle);
+    atlasHandle = InvalidTexture;
+    atlas = nullptr;
     
     // Close font
     if (font) {
@@ -40,77 +40,168 @@ bool TextRenderer::LoadFont(const std::string& path, int fontSize) {
     }
     
     // Load new font
-    font = TTF_OpenFont(path.c_str(), fontSize);
+    font = TTF_OpenFont(path.c_str(), (float)fontSize);
     if (!font) {
-        std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
+        LOG_ERROR(Assets, "Failed to load font: %s", SDL_GetError());
         return false;
     }
+    lineHeight = TTF_GetFontHeight(font);
     
-    return true;
+    // Glyphs from any previous font are stale
+    if (atlas || CreateAtlas()) {
+        ResetAtlas();
+    }
+    return atlas != nullptr;
 #else
     // SDL_ttf not available
     return false;
 #endif
 }
 
-void TextRenderer::DrawText(const std::string& text, float x, float y, const Color& color, bool centered) {
 #ifndef NO_SDL_TTF
-    if (font) {
-        // Check if text is already cached
-        std::string cacheKey = text + "_" + std::to_string(color.r) + "_" + 
-                            std::to_string(color.g) + "_" + 
-                            std::to_string(color.b) + "_" + 
-                            std::to_string(color.a);
-        
-        SDL_Texture* texture = nullptr;
+bool TextRenderer::CreateAtlas() {
+    // Largest power-of-two square that fits the budget at 4 bytes per pixel
+    atlasSize = 64;
+    while ((atlasSize * 2) * (atlasSize * 2) * 4 <= atlasBudget) {
+        atlasSize *= 2;
+    }
+    
+    atlasHandle = graphics->CreateTexture(atlasSize, atlasSize, SDL_TEXTUREACCESS_STATIC,
+                                          SDL_PIXELFORMAT_RGBA32);
+    atlas = graphics->GetTexture(atlasHandle);
+    if (!atlas) {
+        LOG_ERROR(Render, "Failed to create glyph atlas");
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    stats.atlasBytes = atlasSize * atlasSize * 4;
+    return true;
+}
+
+void TextRenderer::ResetAtlas() {
+    // Old pixels stay in the texture but nothing refers to them any more
+    glyphs.clear();
+    shelfX = shelfY = shelfHeight = 0;
+    stats.glyphs = 0;
+    atlasGeneration++;
+}
+
+const TextRenderer::Glyph* TextRenderer::GetGlyph(Uint32 codepoint) {
+    auto it = glyphs.find(codepoint);
+    if (it != glyphs.end()) {
+        stats.hits++;
+        return &it->second;
+    }
+    
+    stats.misses++;
+    return RasterizeGlyph(codepoint);
+}
+
+const TextRenderer::Glyph* TextRenderer::RasterizeGlyph(Uint32 codepoint) {
+    int minx, maxx, miny, maxy, advance;
+    if (!TTF_GetGlyphMetrics(font, codepoint, &minx, &maxx, &miny, &maxy, &advance)) {
+        return nullptr;
+    }
+    
+    Glyph glyph = { SDL_Rect{0, 0, 0, 0}, advance };
+    
+    // Rasterize in white; DrawText tints with vertex color
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, codepoint, SDL_Color{255, 255, 255, 255});
+    if (rendered) {
+        SDL_Surface* surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(rendered);
+        if (!surface) {
+            return nullptr;
+        }
         
-        // Try to find in cache
-        auto it = textCache.find(cacheKey);
-        if (it != textCache.end()) {
-            texture = it->second;
-        } else {
-            // Create SDL color
-            SDL_Color sdlColor = { color.r, color.g, color.b, color.a };
-            
-            // Render text to surface
-            SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), sdlColor);
-            if (!surface) {
-                std::cerr << "Failed to render text: " << TTF_GetError() << std::endl;
-                DrawTextFallback(text, x, y, color, centered);
-                return;
-            }
-            
-            // Create texture from surface
-            texture = SDL_CreateTextureFromSurface(renderer, surface);
+        // Start a new shelf when this one is full, and empty the whole atlas
+        // when there is no room for another shelf
+        if (shelfX + surface->w > atlasSize) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (shelfY + surface->h > atlasSize) {
+            ResetAtlas();
+            stats.evictions++;
+        }
+        if (surface->w > atlasSize || surface->h > atlasSize) {
             SDL_DestroySurface(surface);
-            
-            if (!texture) {
-                std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
-                DrawTextFallback(text, x, y, color, centered);
-                return;
-            }
-            
-            // Cache the texture
-            textCache[cacheKey] = texture;
+            return nullptr;
         }
         
-        // Get texture dimensions
-        int width, height;
-        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+        glyph.atlasRect = SDL_Rect{shelfX, shelfY, surface->w, surface->h};
+        SDL_UpdateTexture(atlas, &glyph.atlasRect, surface->pixels, surface->pitch);
+        SDL_DestroySurface(surface);
         
-        // Calculate position
-        float textX = x;
-        float textY = y;
-        
-        if (centered) {
-            textX -= width / 2.0f;
-            textY -= height / 2.0f;
+        shelfX += glyph.atlasRect.w;
+        shelfHeight = std::max(shelfHeight, glyph.atlasRect.h);
+    }
+    
+    stats.glyphs++;
+    return &glyphs.emplace(codepoint, glyph).first->second;
+}
+
+void TextRenderer::LayoutGlyphs(std::string_view text, float x, float y, const Color& color, bool centered,
+                                TextLayout& layout) {
+    // Make sure every glyph is resident first. If the atlas was emptied
+    // part way through, the earlier glyphs are gone, so look them up again.
+    long long evictions = stats.evictions;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        for (unsigned char c : text) {
+            GetGlyph(c);
         }
+        if (stats.evictions == evictions) break;
+        evictions = stats.evictions;
+    }
+    
+    SDL_FPoint size = GetTextSize(text);
+    float penX = centered ? x - size.x / 2.0f : x;
+    float penY = centered ? y - size.y / 2.0f : y;
+    
+    SDL_FColor tint = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    float inverseSize = 1.0f / atlasSize;
+    layout.vertices.clear();
+    layout.indices.clear();
+    layout.atlasGeneration = atlasGeneration;
+    
+    for (unsigned char c : text) {
+        auto it = glyphs.find(c);
+        if (it == glyphs.end()) continue;
         
-        // Draw texture
-        SDL_FRect destRect = { textX, textY, (float)width, (float)height };
-        SDL_RenderTexture(renderer, texture, nullptr, &destRect);
-        
+        const Glyph& glyph = it->second;
+        const SDL_Rect& src = glyph.atlasRect;
+        if (src.w > 0 && src.h > 0) {
+            float x0 = penX;
+            float y0 = penY;
+            float x1 = penX + src.w;
+            float y1 = penY + src.h;
+            float u0 = src.x * inverseSize;
+            float v0 = src.y * inverseSize;
+            float u1 = (src.x + src.w) * inverseSize;
+            float v1 = (src.y + src.h) * inverseSize;
+            
+            int base = (int)layout.vertices.size();
+            layout.vertices.push_back(SDL_Vertex{ {x0, y0}, tint, {u0, v0} });
+            layout.vertices.push_back(SDL_Vertex{ {x1, y0}, tint, {u1, v0} });
+            layout.vertices.push_back(SDL_Vertex{ {x1, y1}, tint, {u1, v1} });
+            layout.vertices.push_back(SDL_Vertex{ {x0, y1}, tint, {u0, v1} });
+            
+            const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int i : quad) {
+                layout.indices.push_back(base + i);
+            }
+        }
+        penX += glyph.advance;
+    }
+}
+#endif
+
+void TextRenderer::DrawText(std::string_view text, float x, float y, const Color& color, bool centered) {
+#ifndef NO_SDL_TTF
+    if (font && atlas) {
+        LayoutGlyphs(text, x, y, color, centered, scratch);
+        DrawLayout(scratch);
         return;
     }
 #endif
@@ -119,12 +210,43 @@ void TextRenderer::DrawText(const std::string& text, float x, float y, const Col
     DrawTextFallback(text, x, y, color, centered);
 }
 
-SDL_FPoint TextRenderer::GetTextSize(const std::string& text) {
+bool TextRenderer::Layout(std::string_view text, float x, float y, const Color& color, bool centered,
+                          TextLayout& layout) {
 #ifndef NO_SDL_TTF
-    if (font) {
-        int width, height;
-        TTF_SizeText(font, text.c_str(), &width, &height);
-        return { (float)width, (float)height };
+    if (font && atlas) {
+        LayoutGlyphs(text, x, y, color, centered, layout);
+        return true;
+    }
+#endif
+    return false;
+}
+
+void TextRenderer::DrawLayout(const TextLayout& layout) {
+#ifndef NO_SDL_TTF
+    if (atlas && !layout.indices.empty()) {
+        graphics->DrawGeometry(atlas, layout.vertices.data(), (int)layout.vertices.size(),
+                               layout.indices.data(), (int)layout.indices.size());
+    }
+#endif
+}
+
+SDL_FPoint TextRenderer::GetTextSize(std::string_view text) {
+#ifndef NO_SDL_TTF
+    if (font && atlas) {
+        // Sum of advances of the resident glyphs, without rasterizing new ones
+        int width = 0;
+        for (unsigned char c : text) {
+            auto it = glyphs.find(c);
+            if (it != glyphs.end()) {
+                width += it->second.advance;
+            } else {
+                int minx, maxx, miny, maxy, advance;
+                if (TTF_GetGlyphMetrics(font, c, &minx, &maxx, &miny, &maxy, &advance)) {
+                    width += advance;
+                }
+            }
+        }
+        return { (float)width, (float)lineHeight };
     }
 #endif
     
@@ -132,7 +254,7 @@ SDL_FPoint TextRenderer::GetTextSize(const std::string& text) {
     return { text.length() * (charWidth + charSpacing), charHeight };
 }
 
-void TextRenderer::DrawTextFallback(const std::string& text, float x, float y, const Color& color, bool centered) {
+void TextRenderer::DrawTextFallback(std::string_view text, float x, float y, const Color& color, bool centered) {
     float totalWidth = text.length() * (charWidth + charSpacing);
     
     // Calculate start position
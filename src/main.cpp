@@ -1,14 +1,457 @@
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <vector>
 #include "Game.h"
+#include "Graphics.h"
+#include "Replay.h"
+#include "MappedFile.h"
+#include "Log.h"
+#include "SimulationThread.h"
+#include "FramePacer.h"
 
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 
+struct LaunchOptions {
+    bool headless = false;
+    long long ticks = 100000;
+    int tickRate = 120;          // Simulation ticks per second
+    int maxCatchUpSteps = 8;     // Most ticks run back to back; older backlog is dropped
+    int targetFPS = -1;          // Frames per second to pace to; -1 is 60, or uncapped under --stress
+    int vsync = 0;               // SDL_SetRenderVSync mode: 0 off, 1 on, SDL_RENDERER_VSYNC_ADAPTIVE
+    int soakLevels = 0;          // If set, run this many level transitions and exit
+    long long textureBudgetMB = 0;  // 0 keeps the Graphics default
+
+    // Stress mode: a huge formation, auto-fire, a fixed run time
+    bool stress = false;
+    int stressColumns = 100;
+    int stressRows = 40;
+    float fireRate = 1.0f;        // Enemy fire rate multiplier
+    int playerBullets = 0;        // 0 keeps the mode's default
+    int durationSeconds = 30;     // Stress run length
+    int threads = 0;              // Simulation threads; 0 uses every core
+
+    // Replays
+    unsigned long long seed = 0;  // 0 keeps the default seed
+    std::string recordPath;       // Record input to this file
+    std::string replayPath;       // Play this file back instead of reading input
+    long long seekTick = 0;       // Start playback at this tick
+
+    // Snapshots
+    std::string loadSnapshotPath;  // Start from this snapshot instead of level 1
+    std::string saveSnapshotPath;  // Write a snapshot here on exit
+
+    std::string logPath;  // Log here instead of stderr
+};
+
+static bool ParseVSync(const std::string& mode, int& vsync) {
+    if (mode == "off") vsync = 0;
+    else if (mode == "on") vsync = 1;
+    else if (mode == "adaptive") vsync = SDL_RENDERER_VSYNC_ADAPTIVE;
+    else return false;
+    return true;
+}
+
+static bool ParseOptions(int argc, char* argv[], LaunchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            options.ticks = std::atoll(argv[++i]);
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            options.tickRate = std::atoi(argv[++i]);
+        } else if (arg == "--max-catchup" && i + 1 < argc) {
+            options.maxCatchUpSteps = std::atoi(argv[++i]);
+        } else if (arg == "--fps" && i + 1 < argc) {
+            options.targetFPS = std::atoi(argv[++i]);
+        } else if (arg == "--vsync" && i + 1 < argc && ParseVSync(argv[i + 1], options.vsync)) {
+            i++;
+        } else if (arg == "--soak-levels" && i + 1 < argc) {
+            options.soakLevels = std::atoi(argv[++i]);
+        } else if (arg == "--texture-budget" && i + 1 < argc) {
+            options.textureBudgetMB = std::atoll(argv[++i]);
+        } else if (arg == "--stress") {
+            options.stress = true;
+        } else if (arg == "--formation" && i + 2 < argc) {
+            options.stressColumns = std::atoi(argv[++i]);
+            options.stressRows = std::atoi(argv[++i]);
+        } else if (arg == "--fire-rate" && i + 1 < argc) {
+            options.fireRate = (float)std::atof(argv[++i]);
+        } else if (arg == "--player-bullets" && i + 1 < argc) {
+            options.playerBullets = std::atoi(argv[++i]);
+        } else if (arg == "--duration" && i + 1 < argc) {
+            options.durationSeconds = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--record" && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--seek" && i + 1 < argc) {
+            options.seekTick = std::atoll(argv[++i]);
+        } else if (arg == "--load-snapshot" && i + 1 < argc) {
+            options.loadSnapshotPath = argv[++i];
+        } else if (arg == "--save-snapshot" && i + 1 < argc) {
+            options.saveSnapshotPath = argv[++i];
+        } else if (arg == "--log" && i + 1 < argc) {
+            options.logPath = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0]
+                      << " [--headless [--ticks N]] [--tick-rate HZ] [--max-catchup N]"
+                      << " [--fps N] [--vsync off|on|adaptive]"
+                      << " [--soak-levels N] [--texture-budget MB]"
+                      << " [--stress [--formation COLS ROWS] [--duration S]]"
+                      << " [--fire-rate X] [--player-bullets N] [--threads N]"
+                      << " [--seed N] [--record FILE] [--replay FILE [--seek TICK]]"
+                      << " [--load-snapshot FILE] [--save-snapshot FILE] [--log FILE]" << std::endl;
+            return false;
+        }
+    }
+    return options.ticks > 0 && options.tickRate > 0 && options.maxCatchUpSteps > 0 &&
+           options.targetFPS >= -1 &&
+           options.soakLevels >= 0 && options.textureBudgetMB >= 0 &&
+           options.stressColumns > 0 && options.stressRows > 0 && options.fireRate > 0.0f &&
+           options.playerBullets >= 0 && options.durationSeconds > 0 &&
+           options.threads >= 0 && options.seekTick >= 0 &&
+           // Playback takes its config and input from the file
+           (options.replayPath.empty() || (!options.stress && options.recordPath.empty() &&
+                                           options.soakLevels == 0)) &&
+           // A replay can only start from a fresh game
+           (options.loadSnapshotPath.empty() || (options.replayPath.empty() && options.recordPath.empty()));
+}
+
+static GameConfig MakeConfig(const LaunchOptions& options) {
+    GameConfig config = options.stress
+        ? GameConfig::Stress(options.stressColumns, options.stressRows)
+        : GameConfig();
+    config.enemyFireRate = options.fireRate;
+    config.workerThreads = options.threads;
+    if (options.playerBullets > 0) {
+        config.maxPlayerBullets = options.playerBullets;
+    }
+    if (options.seed != 0) {
+        config.seed = options.seed;
+    }
+    return config;
+}
+
+// The recorded config; only the thread count, which cannot change the
+// result, comes from the command line
+static GameConfig ReplayConfig(const LaunchOptions& options, const ReplayPlayer& replay) {
+    GameConfig config = replay.GetConfig();
+    config.workerThreads = options.threads;
+    return config;
+}
+
+// Maps the --load-snapshot file and takes its config, with the thread count
+// from the command line
+static bool OpenStartSnapshot(const LaunchOptions& options, MappedFile& file, GameConfig& config) {
+    if (!file.Open(options.loadSnapshotPath)) {
+        return false;
+    }
+    if (!Game::ReadSnapshotConfig(file.Data(), file.Size(), config)) {
+        LOG_ERROR(General, "%s is not a snapshot this build can load", options.loadSnapshotPath.c_str());
+        return false;
+    }
+    config.workerThreads = options.threads;
+    return true;
+}
+
+// Replace the fresh board with the mapped snapshot, if there is one
+static bool RestoreStartSnapshot(Game& game, const MappedFile& file) {
+    if (!file.Data()) {
+        return true;
+    }
+    Uint64 start = SDL_GetTicksNS();
+    if (!game.LoadSnapshot(file.Data(), file.Size())) {
+        LOG_ERROR(General, "Snapshot could not be restored");
+        return false;
+    }
+    std::cout << "Restored " << file.Size() << " byte snapshot in "
+              << (SDL_GetTicksNS() - start) / 1000.0 << " us" << std::endl;
+    return true;
+}
+
+static void SaveExitSnapshot(const Game& game, const LaunchOptions& options) {
+    if (options.saveSnapshotPath.empty()) {
+        return;
+    }
+    if (game.SaveSnapshotFile(options.saveSnapshotPath)) {
+        std::cout << "Saved snapshot of tick " << game.GetTick() << " to " << options.saveSnapshotPath << std::endl;
+    }
+}
+
+// Keyframes every five seconds of play
+static std::unique_ptr<ReplayRecorder> StartRecording(Game& game, const LaunchOptions& options) {
+    if (options.recordPath.empty()) {
+        return nullptr;
+    }
+    auto recorder = std::make_unique<ReplayRecorder>(game.GetConfig(), options.tickRate, options.tickRate * 5);
+    game.SetRecorder(recorder.get());
+    return recorder;
+}
+
+static void FinishRecording(Game& game, ReplayRecorder* recorder, const LaunchOptions& options) {
+    if (!recorder) {
+        return;
+    }
+    game.SetRecorder(nullptr);
+    if (recorder->Save(options.recordPath, game.GetTick())) {
+        std::cout << "Recorded " << game.GetTick() << " ticks to " << options.recordPath << " ("
+                  << recorder->Size() << " bytes)" << std::endl;
+    }
+}
+
+// Frame times of a stress run, logged once a second and summarised at the end
+class StressLog {
+public:
+    // Call after the frame that drew snapshot has ended
+    void Record(const RenderSnapshot& snapshot, const FrameProfiler& profiler) {
+        if (profiler.FrameCount() == 0) return;
+        const FrameTiming& timing = profiler.GetFrame(0);
+        Uint64 frameNS = timing.frameNS;
+        frameTimes.push_back(frameNS);
+        secondTimes.push_back(frameNS);
+        for (int phase = 0; phase < framePhaseCount; phase++) {
+            phaseTotals[phase] += timing.phaseNS[phase];
+        }
+
+        elapsedNS += frameNS;
+        if (elapsedNS >= nextReportNS) {
+            nextReportNS += SDL_NS_PER_SECOND;
+            LOG_INFO(General, "t=%llus  %zu frames  p50 %g ms  p99 %g ms  enemies %d  bullets %d",
+                     (unsigned long long)(elapsedNS / SDL_NS_PER_SECOND), secondTimes.size(),
+                     Percentile(secondTimes, 0.50), Percentile(secondTimes, 0.99),
+                     (int)snapshot.enemies.size(), (int)snapshot.projectiles.size());
+            secondTimes.clear();
+        }
+    }
+
+    void Report() {
+        if (frameTimes.empty()) return;
+        std::cout << "Stress run: " << frameTimes.size() << " frames, frame time p50 "
+                  << Percentile(frameTimes, 0.50) << " ms, p90 " << Percentile(frameTimes, 0.90)
+                  << " ms, p99 " << Percentile(frameTimes, 0.99) << " ms, p99.9 "
+                  << Percentile(frameTimes, 0.999) << " ms, max " << Percentile(frameTimes, 1.0)
+                  << " ms" << std::endl;
+#ifdef INVADERS_PROFILING
+        std::cout << "Average per frame:";
+        for (int phase = 0; phase < framePhaseCount; phase++) {
+            std::cout << " " << GetFramePhaseName((FramePhase)phase) << " "
+                      << phaseTotals[phase] / 1e6 / frameTimes.size() << " ms";
+        }
+        std::cout << std::endl;
+#endif
+    }
+
+private:
+    std::vector<Uint64> frameTimes;
+    std::vector<Uint64> secondTimes;
+    double phaseTotals[framePhaseCount] = {};
+    Uint64 elapsedNS = 0;
+    Uint64 nextReportNS = SDL_NS_PER_SECOND;
+
+    // In milliseconds; sorts samples
+    static double Percentile(std::vector<Uint64>& samples, double p) {
+        if (samples.empty()) return 0.0;
+        size_t index = (size_t)(p * (samples.size() - 1) + 0.5);
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index] / 1e6;
+    }
+};
+
+// Adaptive vsync is not available everywhere; fall back to plain vsync
+static void ApplyVSync(SDL_Renderer* renderer, int vsync) {
+    if (vsync == 0 || SDL_SetRenderVSync(renderer, vsync)) {
+        return;
+    }
+    if (vsync == SDL_RENDERER_VSYNC_ADAPTIVE && SDL_SetRenderVSync(renderer, 1)) {
+        LOG_WARNING(Render, "Adaptive vsync is not supported, using vsync");
+        return;
+    }
+    LOG_WARNING(Render, "Vsync could not be enabled! SDL_Error: %s", SDL_GetError());
+}
+
+static void PrintPacingStats(const FramePacer& pacer) {
+    FramePacingStats stats = pacer.GetStats();
+    if (stats.frames == 0) return;
+    std::cout << "Frame pacing: " << stats.frames << " frames";
+    if (pacer.GetPeriodNS() > 0) {
+        std::cout << " at " << pacer.GetPeriodNS() / 1e6 << " ms";
+    }
+    std::cout << ", interval mean " << stats.meanMS << " ms, jitter " << stats.jitterMS
+              << " ms, worst error " << stats.worstErrorMS << " ms, " << stats.missed
+              << " missed, slept " << stats.sleptMS << " ms, spun " << stats.spunMS << " ms" << std::endl;
+}
+
+// Stress runs play themselves: the player holds fire from the start
+static void HoldFire(Game& game) {
+    SDL_Event event{};
+    event.type = SDL_EVENT_KEY_DOWN;
+    event.key.scancode = SDL_SCANCODE_SPACE;
+    game.HandleEvent(event);
+}
+
+// Step the simulation as fast as possible with no window or renderer and
+// report throughput. Restarts whenever the game ends so every tick does work.
+static int RunHeadless(const LaunchOptions& options, const GameConfig& config, const MappedFile& startSnapshot) {
+    Game game(config);
+    game.Initialize();
+    if (!RestoreStartSnapshot(game, startSnapshot)) {
+        return -1;
+    }
+    std::unique_ptr<ReplayRecorder> recorder = StartRecording(game, options);
+    if (options.stress) {
+        HoldFire(game);
+    }
+
+    const float tickSeconds = 1.0f / options.tickRate;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (long long tick = 0; tick < options.ticks; tick++) {
+        game.Update(tickSeconds);
+        if (game.IsGameOver()) {
+            game.Restart();
+        }
+    }
+    Uint64 end = SDL_GetPerformanceCounter();
+
+    double seconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    double ticksPerSecond = seconds > 0.0 ? options.ticks / seconds : 0.0;
+    std::cout << "Simulated " << options.ticks << " ticks in " << seconds << " s ("
+              << (long long)ticksPerSecond << " ticks/sec)" << std::endl;
+    FinishRecording(game, recorder.get(), options);
+    SaveExitSnapshot(game, options);
+    return 0;
+}
+
+// Re-simulate a replay as fast as possible with no window or renderer.
+// Reports throughput, the slowest tick, and whether every keyframe matched.
+static int RunReplay(const LaunchOptions& options, ReplayPlayer& replay) {
+    Game game(ReplayConfig(options, replay));
+    game.Initialize();
+    if (options.seekTick > 0 && !replay.Seek(game, (Uint64)options.seekTick)) {
+        return -1;
+    }
+
+    const float tickSeconds = 1.0f / replay.GetTickRate();
+    const Uint64 firstTick = game.GetTick();
+    Uint64 slowestNS = 0;
+    Uint64 slowestTick = 0;
+    Uint64 start = SDL_GetTicksNS();
+    while (!replay.IsFinished(game)) {
+        replay.Feed(game);
+        Uint64 tickStart = SDL_GetTicksNS();
+        game.Update(tickSeconds);
+        Uint64 tickNS = SDL_GetTicksNS() - tickStart;
+        if (tickNS > slowestNS) {
+            slowestNS = tickNS;
+            slowestTick = game.GetTick() - 1;
+        }
+    }
+    Uint64 elapsedNS = SDL_GetTicksNS() - start;
+
+    Uint64 ticks = game.GetTick() - firstTick;
+    double seconds = elapsedNS / 1e9;
+    std::cout << "Replayed " << ticks << " ticks in " << seconds << " s ("
+              << (long long)(seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/sec)" << std::endl;
+    std::cout << "Slowest tick: " << slowestTick << " (" << slowestNS / 1e6 << " ms)" << std::endl;
+    std::cout << "Final score " << game.GetScore() << ", level " << game.GetLevel() << std::endl;
+
+    if (replay.HasDesynced()) {
+        std::cout << "DESYNC: state differs from the recording at tick " << replay.GetDesyncTick() << std::endl;
+        return 1;
+    }
+    std::cout << "Matched every keyframe" << std::endl;
+    SaveExitSnapshot(game, options);
+    return 0;
+}
+
+static void PrintTextureStats(const char* label, const TextureCacheStats& stats) {
+    std::cout << label << ": " << stats.textures << " textures, " << stats.resident
+              << " resident (" << stats.residentBytes << " bytes), " << stats.loads
+              << " loads, " << stats.evictions << " evictions" << std::endl;
+}
+
+// Run level transitions back to back, drawing a frame after each, and check
+// that render memory ends where it started. Every 50th transition is a full
+// restart so the barriers are rebuilt too.
+static int RunSoak(Game& game, const LaunchOptions& options) {
+    Graphics* graphics = game.GetGraphics();
+    const float tickSeconds = 1.0f / options.tickRate;
+    SDL_Event e;
+
+    // One frame first so the barrier textures and HUD glyphs exist
+    game.Update(tickSeconds);
+    game.Render();
+    TextureCacheStats before = graphics->GetTextureStats();
+
+    for (int i = 1; i <= options.soakLevels; i++) {
+        while (SDL_PollEvent(&e)) {
+        }
+        if (i % 50 == 0) {
+            game.Restart();
+        } else {
+            game.AdvanceLevel();
+        }
+        game.Update(tickSeconds);
+        game.Render();
+    }
+
+    TextureCacheStats after = graphics->GetTextureStats();
+    PrintTextureStats("Before soak", before);
+    PrintTextureStats("After soak", after);
+
+    bool flat = after.textures == before.textures && after.residentBytes <= before.residentBytes;
+    std::cout << options.soakLevels << " level transitions: render memory "
+              << (flat ? "flat" : "GREW") << std::endl;
+    return flat ? 0 : 1;
+}
+
+// Writes out every queued message however main returns
+struct LogSession {
+    ~LogSession() { StopLogging(); }
+};
+
 int main(int argc, char* argv[]) {
+    LaunchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return -1;
+    }
+    if (!StartLogging(options.logPath.c_str())) {
+        return -1;
+    }
+    LogSession logSession;
+
+    ReplayPlayer replay;
+    const bool replaying = !options.replayPath.empty();
+    if (replaying) {
+        if (!replay.Load(options.replayPath)) {
+            return -1;
+        }
+        options.tickRate = replay.GetTickRate();
+    }
+
+    MappedFile startSnapshot;
+    GameConfig config = replaying ? ReplayConfig(options, replay) : MakeConfig(options);
+    if (!options.loadSnapshotPath.empty() && !OpenStartSnapshot(options, startSnapshot, config)) {
+        return -1;
+    }
+
+    if (options.headless) {
+        return replaying ? RunReplay(options, replay) : RunHeadless(options, config, startSnapshot);
+    }
+
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR(General, "SDL could not initialize! SDL_Error: %s", SDL_GetError());
         return -1;
     }
 
@@ -20,51 +463,119 @@ int main(int argc, char* argv[]) {
     );
 
     if (!window) {
-        std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR(General, "Window could not be created! SDL_Error: %s", SDL_GetError());
         return -1;
     }
 
     // Create renderer
     SDL_Renderer* renderer = SDL_CreateRenderer(window, NULL);
     if (!renderer) {
-        std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR(General, "Renderer could not be created! SDL_Error: %s", SDL_GetError());
         return -1;
     }
 
+    ApplyVSync(renderer, options.vsync);
+
     // Initialize game
-    Game game(window, renderer);
+    Game game(window, renderer, config);
     game.Initialize();
+    if (!RestoreStartSnapshot(game, startSnapshot)) {
+        return -1;
+    }
+    std::unique_ptr<ReplayRecorder> recorder = StartRecording(game, options);
+    if (replaying && options.seekTick > 0 && !replay.Seek(game, (Uint64)options.seekTick)) {
+        return -1;
+    }
+    if (options.textureBudgetMB > 0) {
+        game.GetGraphics()->SetTextureBudget((size_t)options.textureBudgetMB * 1024 * 1024);
+    }
+
+    if (options.soakLevels > 0) {
+        int result = RunSoak(game, options);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return result;
+    }
+
+    // Main game loop: the simulation advances in fixed ticks on its own
+    // thread; this one handles events and draws the newest snapshot as often
+    // as it can, interpolating between its last two ticks
+    SimulationThread simulation(game, options.tickRate, options.maxCatchUpSteps);
+    if (replaying) {
+        simulation.SetBeforeTick([&replay](Game& game) {
+            if (replay.IsFinished(game)) {
+                return false;
+            }
+            replay.Feed(game);
+            return true;
+        });
+    }
+    if (options.stress) {
+        // Keep the load up: start over whenever the formation wins
+        HoldFire(game);
+        simulation.SetAfterTick([](Game& game) {
+            if (game.IsGameOver()) {
+                game.Restart();
+                HoldFire(game);
+            }
+            return true;
+        });
+    }
 
-    // Main game loop
     bool quit = false;
     SDL_Event e;
-    Uint64 lastTime = SDL_GetTicks();
+    FramePacer pacer(options.targetFPS >= 0 ? options.targetFPS : options.stress ? 0 : 60);
+    StressLog stressLog;
+    const Uint64 stressEnd = SDL_GetTicksNS() + (Uint64)options.durationSeconds * SDL_NS_PER_SECOND;
+    simulation.Start();
     
     while (!quit) {
         // Handle events
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_EVENT_QUIT) {
-                quit = true;
+        {
+            PROFILE_PHASE(game.GetProfiler(), FramePhase::Events);
+            while (SDL_PollEvent(&e)) {
+                if (e.type == SDL_EVENT_QUIT) {
+                    quit = true;
+                }
+                // The renderer dropped the contents of its render targets
+                if (e.type == SDL_EVENT_RENDER_TARGETS_RESET) {
+                    game.InvalidateStaticLayer();
+                }
+                // During playback the recording supplies the input; only
+                // the performance overlay can still be toggled
+                if (!replaying || (e.type == SDL_EVENT_KEY_DOWN && e.key.scancode == SDL_SCANCODE_F3)) {
+                    simulation.PostEvent(e);
+                }
             }
-            game.HandleEvent(e);
         }
-
-        // Calculate delta time
-        Uint64 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
-
-        // Cap delta time to prevent physics issues on lag spikes
-        if (deltaTime > 0.05f) {
-            deltaTime = 0.05f;
+        if (simulation.IsFinished()) {
+            break;
         }
 
-        // Update and render
-        game.Update(deltaTime);
-        game.Render();
+        const RenderSnapshot& frame = simulation.AcquireFrame();
+        game.Draw(frame, simulation.GetAlpha(frame, SDL_GetTicksNS()));
+        
+        pacer.Wait();
+        game.GetProfiler().EndFrame();
         
-        // Delay to cap framerate if needed
-        SDL_Delay(1);
+        if (options.stress) {
+            stressLog.Record(frame, game.GetProfiler());
+            if (SDL_GetTicksNS() >= stressEnd) {
+                quit = true;
+            }
+        }
+    }
+    simulation.Stop();
+    
+    if (options.stress) {
+        stressLog.Report();
+    }
+    PrintPacingStats(pacer);
+    FinishRecording(game, recorder.get(), options);
+    SaveExitSnapshot(game, options);
+    if (replaying && replay.HasDesynced()) {
+        std::cout << "DESYNC: state differs from the recording at tick " << replay.GetDesyncTick() << std::endl;
     }
 
     // Cleanup